@@ -5,7 +5,22 @@ Deze file bevat type hints voor alle classes, functies en enums
 die geëxposeerd worden via pybind11.
 """
 
-from typing import Dict, Any, List, Union
+import asyncio
+from typing import Dict, Any, List, Optional, Protocol, Sequence, Union
+
+# JSON input zonder kopie: str (UTF-8) of een object met het buffer protocol
+JsonInput = Union[str, bytes, bytearray, memoryview]
+# Schrijfbare buffer voor het resultaat (into=...)
+WritableBuffer = Union[bytearray, memoryview]
+# str standaard, bytes met as_bytes=True, aantal geschreven bytes met into
+RenderResult = Union[str, bytes, int]
+
+class SupportsWrite(Protocol):
+    """File object voor streaming output (str voor io.TextIOBase, anders bytes)."""
+    def write(self, data: Any, /) -> Any: ...
+
+# Bestemming voor dump()/print_to(): file descriptor of file object
+OutputFile = Union[int, SupportsWrite]
 
 # Enums
 class ColorMode:
@@ -28,6 +43,8 @@ class ElementType:
     COLON: ElementType
     COMMA: ElementType
     WHITESPACE: ElementType
+    KEY_QUOTE: ElementType
+    STRING_QUOTE: ElementType
 
 # Classes
 class Color:
@@ -75,8 +92,29 @@ class Color:
         """
         ...
 
+class StyleColor:
+    """Kleur van een Style (style.key_color) die direct in de Style leest en schrijft.
+    
+    Bruikbaar overal waar een Color verwacht wordt; Color(style.key_color)
+    geeft een losse kopie.
+    """
+    
+    r: int  # 0-255
+    g: int  # 0-255
+    b: int  # 0-255
+    bold: bool
+    italic: bool
+    underline: bool
+    
+    def to_ansi(self, mode: ColorMode = ColorMode.AUTO) -> str:
+        """Converteer naar ANSI escape code string."""
+        ...
+
 class Style:
-    """Stijl configuratie voor kleuring en formatting van JSON."""
+    """Stijl configuratie voor kleuring en formatting van JSON.
+    
+    Kleur properties geven een StyleColor terug die in de Style schrijft.
+    """
     
     key_color: Color
     string_color: Color
@@ -94,6 +132,9 @@ class Style:
     color_mode: ColorMode
     compact: bool
     indent_size: int
+    verbatim_strings: bool
+    css_classes: bool
+    threads: int
     
     def __init__(self) -> None:
         """Maak een nieuwe Style met standaard kleuren."""
@@ -112,7 +153,8 @@ class Style:
         """Stel individuele kleur in voor een value op basis van pad.
         
         Args:
-            path: Pad naar de value (bijv. "user.name", "products[0].price")
+            path: Pad naar de value (bijv. "user.name", "products[0].price",
+                "users[*].email"); `*` en `[*]` matchen elke key of index
             color: Color object voor deze value
         """
         ...
@@ -147,11 +189,19 @@ class Style:
 class Printer:
     """Printer class voor console output met ANSI kleuren."""
     
-    def __init__(self, style: Style) -> None:
+    max_capacity: int  # Bytes per buffer tussen aanroepen (0 = geen limiet)
+    
+    def __init__(self, style: Style, max_capacity: int = 0) -> None:
         """Maak een nieuwe Printer instance.
         
+        De printer houdt zijn parser, output buffer en gecompileerde Style
+        vast tussen aanroepen. Hergebruik één printer per thread voor veel
+        kleine documenten.
+        
         Args:
             style: Style object voor kleuring en formatting
+            max_capacity: Maximaal aantal bytes per buffer dat tussen aanroepen
+                vastgehouden wordt (0 = geen limiet)
         """
         ...
     
@@ -167,15 +217,42 @@ class Printer:
             Gekleurde string met ANSI escape codes
         """
         ...
+    
+    def print_to(
+        self,
+        obj: Union[JsonInput, Any],
+        file: OutputFile,
+        *,
+        chunk_size: int = 65536
+    ) -> None:
+        """Formatteer en schrijf in blokken naar een file descriptor of file object.
+        
+        Het geheugengebruik blijft begrensd, ook voor zeer grote documenten.
+        Naar een file descriptor wordt zonder GIL geschreven.
+        
+        Args:
+            obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+            file: File descriptor (int) of object met een write() methode
+            chunk_size: Grootte van de blokken in bytes
+        """
+        ...
 
 class HtmlPrinter:
     """Printer class voor HTML output generatie."""
     
-    def __init__(self, style: Style) -> None:
+    max_capacity: int  # Bytes per buffer tussen aanroepen (0 = geen limiet)
+    
+    def __init__(self, style: Style, max_capacity: int = 0) -> None:
         """Maak een nieuwe HtmlPrinter instance.
         
+        De printer houdt zijn parser, output buffer en gecompileerde Style
+        vast tussen aanroepen. Hergebruik één printer per thread voor veel
+        kleine documenten.
+        
         Args:
             style: Style object voor kleuring en formatting
+            max_capacity: Maximaal aantal bytes per buffer dat tussen aanroepen
+                vastgehouden wordt (0 = geen limiet)
         """
         ...
     
@@ -204,11 +281,19 @@ class HtmlPrinter:
 class MarkdownPrinter:
     """Printer class voor Markdown output generatie."""
     
-    def __init__(self, style: Style) -> None:
+    max_capacity: int  # Bytes per buffer tussen aanroepen (0 = geen limiet)
+    
+    def __init__(self, style: Style, max_capacity: int = 0) -> None:
         """Maak een nieuwe MarkdownPrinter instance.
         
+        De printer houdt zijn parser, output buffer en gecompileerde Style
+        vast tussen aanroepen. Hergebruik één printer per thread voor veel
+        kleine documenten.
+        
         Args:
             style: Style object voor kleuring en formatting
+            max_capacity: Maximaal aantal bytes per buffer dat tussen aanroepen
+                vastgehouden wordt (0 = geen limiet)
         """
         ...
     
@@ -267,7 +352,13 @@ def print(obj: Any, style: Style = ...) -> None:
     """
     ...
 
-def format(obj: Union[str, Any], style: Style = ...) -> str:
+def format(
+    obj: Union[str, Any],
+    style: Style = ...,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Formatteer een Python object of JSON string als gekleurde string.
     
     Ondersteunt zowel Python objecten (dict, list) als JSON strings.
@@ -276,20 +367,76 @@ def format(obj: Union[str, Any], style: Style = ...) -> str:
     Args:
         obj: Python dict, list, JSON string, of ander object om te formatteren
         style: Optionele Style object (standaard: Style())
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Gekleurde string met ANSI escape codes
     """
     ...
 
-def format_from_json(json_str: str, style: Style = ...) -> str:
+def dump(
+    obj: Union[JsonInput, Any],
+    file: OutputFile,
+    style: Style = ...,
+    *,
+    chunk_size: int = 65536
+) -> None:
+    """Formatteer een Python object of JSON en schrijf het in blokken weg.
+    
+    Het resultaat wordt nooit in zijn geheel opgebouwd, dus het
+    geheugengebruik blijft begrensd, ook voor een JSON document van
+    enkele GB's. bytes, bytearray en memoryview zijn JSON input.
+    
+    Args:
+        obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+        file: File descriptor (int), zonder GIL beschreven, of een object met
+            een write() methode (str voor tekstbestanden, anders bytes)
+        style: Optionele Style object (standaard: Style())
+        chunk_size: Grootte van de blokken in bytes
+    """
+    ...
+
+def format_async(
+    obj: Union[JsonInput, Any],
+    style: Style = ...,
+    *,
+    as_bytes: bool = False
+) -> asyncio.Future[Union[str, bytes]]:
+    """Formatteer een Python object of JSON zonder de event loop te blokkeren.
+    
+    Het renderen gebeurt zonder GIL op de thread pool van de module; het
+    resultaat komt via loop.call_soon_threadsafe in de future. Een Python
+    object wordt eerst (met de GIL) gekopieerd, JSON als str, bytes,
+    bytearray of memoryview zonder kopie gelezen. Moet vanuit een lopende
+    event loop aangeroepen worden.
+    
+    Args:
+        obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+        style: Optionele Style object (standaard: Style()), bij de aanroep gekopieerd
+        as_bytes: Resultaat als bytes in plaats van str
+    
+    Returns:
+        Future met de gekleurde string met ANSI escape codes
+    """
+    ...
+
+def format_from_json(
+    json_str: JsonInput,
+    style: Style = ...,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Formatteer een JSON string als gekleurde string (expliciete functie).
     
     Geoptimaliseerd voor JSON string input met simdjson en GIL release.
     
     Args:
-        json_str: JSON string om te formatteren
+        json_str: JSON als str, bytes, bytearray of memoryview
         style: Optionele Style object (standaard: Style())
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Gekleurde string met ANSI escape codes
@@ -302,7 +449,11 @@ def to_html(
     title: str = "Colored JSON",
     background_color: str = "#1e1e1e",
     font_family: str = "Consolas, 'Courier New', monospace"
-) -> str:
+,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Genereer HTML output van gekleurde JSON (convenience functie).
     
     Ondersteunt zowel Python objecten (dict, list) als JSON strings.
@@ -313,29 +464,61 @@ def to_html(
         title: Titel voor de HTML pagina
         background_color: Achtergrondkleur (CSS kleur string, bijv. "#1e1e1e")
         font_family: Font familie voor de JSON weergave
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Complete HTML string met inline styles
     """
     ...
 
+def to_html_async(
+    obj: Union[JsonInput, Any],
+    style: Style = ...,
+    title: str = "Colored JSON",
+    background_color: str = "#1e1e1e",
+    font_family: str = "Consolas, 'Courier New', monospace",
+    *,
+    as_bytes: bool = False
+) -> asyncio.Future[Union[str, bytes]]:
+    """Genereer HTML output zonder de event loop te blokkeren (zie format_async()).
+    
+    Args:
+        obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+        style: Optionele Style object (standaard: Style()), bij de aanroep gekopieerd
+        title: Titel voor de HTML pagina
+        background_color: Achtergrondkleur (CSS kleur string)
+        font_family: Font familie voor de JSON weergave
+        as_bytes: Resultaat als bytes in plaats van str
+    
+    Returns:
+        Future met de complete HTML string
+    """
+    ...
+
 def to_html_from_json(
-    json_str: str,
+    json_str: JsonInput,
     style: Style = ...,
     title: str = "Colored JSON",
     background_color: str = "#1e1e1e",
     font_family: str = "Consolas, 'Courier New', monospace"
-) -> str:
+,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Genereer HTML output van JSON string (expliciete functie).
     
     Geoptimaliseerd voor JSON string input met simdjson en GIL release.
     
     Args:
-        json_str: JSON string om te formatteren
+        json_str: JSON als str, bytes, bytearray of memoryview
         style: Optionele Style object (standaard: Style())
         title: Titel voor de HTML pagina
         background_color: Achtergrondkleur (CSS kleur string)
         font_family: Font familie voor de JSON weergave
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Complete HTML string met inline styles
@@ -347,7 +530,11 @@ def to_markdown(
     style: Style = ...,
     title: str = "Colored JSON",
     language: str = "json"
-) -> str:
+,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Genereer Markdown output met code block (convenience functie).
     
     Ondersteunt zowel Python objecten (dict, list) als JSON strings.
@@ -357,6 +544,8 @@ def to_markdown(
         style: Optionele Style object (standaard: Style())
         title: Titel voor de Markdown sectie
         language: Code block language identifier (standaard: "json")
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Markdown string met code block
@@ -364,20 +553,26 @@ def to_markdown(
     ...
 
 def to_markdown_from_json(
-    json_str: str,
+    json_str: JsonInput,
     style: Style = ...,
     title: str = "Colored JSON",
     language: str = "json"
-) -> str:
+,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Genereer Markdown output van JSON string (expliciete functie).
     
     Geoptimaliseerd voor JSON string input met simdjson en GIL release.
     
     Args:
-        json_str: JSON string om te formatteren
+        json_str: JSON als str, bytes, bytearray of memoryview
         style: Optionele Style object (standaard: Style())
         title: Titel voor de Markdown sectie
         language: Code block language identifier (standaard: "json")
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Markdown string met code block
@@ -390,7 +585,11 @@ def to_markdown_html(
     title: str = "Colored JSON",
     background_color: str = "#1e1e1e",
     font_family: str = "Consolas, 'Courier New', monospace"
-) -> str:
+,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Genereer Markdown met HTML code block voor gekleurde JSON (convenience functie).
     
     Ondersteunt zowel Python objecten (dict, list) als JSON strings.
@@ -401,6 +600,8 @@ def to_markdown_html(
         title: Titel voor de Markdown sectie
         background_color: Achtergrondkleur (CSS kleur string, bijv. "#1e1e1e")
         font_family: Font familie voor de JSON weergave
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Markdown string met HTML code block
@@ -408,28 +609,110 @@ def to_markdown_html(
     ...
 
 def to_markdown_html_from_json(
-    json_str: str,
+    json_str: JsonInput,
     style: Style = ...,
     title: str = "Colored JSON",
     background_color: str = "#1e1e1e",
     font_family: str = "Consolas, 'Courier New', monospace"
-) -> str:
+,
+    *,
+    as_bytes: bool = False,
+    into: Optional[WritableBuffer] = None
+) -> RenderResult:
     """Genereer Markdown met HTML code block van JSON string (expliciete functie).
     
     Geoptimaliseerd voor JSON string input met simdjson en GIL release.
     
     Args:
-        json_str: JSON string om te formatteren
+        json_str: JSON als str, bytes, bytearray of memoryview
         style: Optionele Style object (standaard: Style())
         title: Titel voor de Markdown sectie
         background_color: Achtergrondkleur (CSS kleur string)
         font_family: Font familie voor de JSON weergave
+        as_bytes: Resultaat als bytes in plaats van str
+        into: Schrijfbare buffer voor het resultaat; geeft het aantal bytes terug
     
     Returns:
         Markdown string met HTML code block
     """
     ...
 
+def render_formats(
+    obj: Union[str, Any],
+    style: Style = ...,
+    formats: List[str] = ["ansi", "html", "markdown"],
+    title: str = "Colored JSON",
+    background_color: str = "#1e1e1e",
+    font_family: str = "Consolas, 'Courier New', monospace",
+    language: str = "json"
+) -> Dict[str, str]:
+    """Render een object of JSON string naar meerdere formaten uit één parse.
+    
+    Het document wordt één keer als token tape opgenomen; elk formaat wordt
+    daarna uit de tape gerenderd, met dezelfde output als de losse functies.
+    
+    Args:
+        obj: Python dict, list, of JSON string
+        style: Optionele Style object (standaard: Style())
+        formats: Lijst met "ansi", "html", "markdown" en/of "markdown_html"
+        title: Titel voor HTML en Markdown
+        background_color: Achtergrondkleur voor HTML en markdown_html
+        font_family: Font familie voor HTML en markdown_html
+        language: Taal voor het Markdown code block
+    
+    Returns:
+        Dict met formaat naam -> gerenderde string
+    """
+    ...
+
+def format_many(
+    inputs: Sequence[JsonInput],
+    style: Style = ...,
+    threads: int = 0
+) -> List[str]:
+    """Formatteer een lijst JSON strings in één aanroep.
+    
+    De GIL wordt één keer vrijgegeven en de documenten worden over native
+    threads verdeeld. Het resultaat is gelijk aan format_from_json per document.
+    
+    Args:
+        inputs: Lijst (of andere sequence) van str, bytes, bytearray of memoryview met JSON
+        style: Optionele Style object (standaard: Style())
+        threads: Aantal threads (0 = alle cores)
+    
+    Returns:
+        Gekleurde strings, in dezelfde volgorde als inputs
+    
+    Raises:
+        RuntimeError: Bij ongeldige JSON, met de index van het document
+    """
+    ...
+
+def to_html_many(
+    inputs: Sequence[JsonInput],
+    style: Style = ...,
+    threads: int = 0,
+    title: str = "Colored JSON",
+    background_color: str = "#1e1e1e",
+    font_family: str = "Consolas, 'Courier New', monospace"
+) -> List[str]:
+    """Genereer HTML output voor een lijst JSON strings in één aanroep.
+    
+    Zoals format_many, met per document dezelfde HTML als to_html_from_json.
+    
+    Args:
+        inputs: Lijst (of andere sequence) van str, bytes, bytearray of memoryview met JSON
+        style: Optionele Style object (standaard: Style())
+        threads: Aantal threads (0 = alle cores)
+        title: Titel voor de HTML pagina's
+        background_color: Achtergrondkleur (CSS kleur string)
+        font_family: Font familie voor de JSON weergave
+    
+    Returns:
+        HTML strings, in dezelfde volgorde als inputs
+    """
+    ...
+
 # Colors submodule
 class colors:
     """Ingebouwde ANSI16 kleuren."""
@@ -0,0 +1,93 @@
+#pragma once
+#include "json_parser.hpp"
+#include "output_buffer.hpp"
+#include "thread_pool.hpp"
+#include <simdjson.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace colored_json {
+
+// Rendert een reeks losse JSON documenten (format_many, to_html_many) op de
+// gedeelde thread pool. Elke runner pakt het volgende document van een
+// teller en gebruikt één parser (uit de ParserPool van zijn thread) en één
+// eigen output buffer voor al zijn documenten; een document is een stuk
+// [offset, offset + length) daarvan.
+// Raakt geen Python objecten aan en kan dus zonder GIL draaien.
+class BatchRenderer {
+private:
+    struct Item {
+        size_t runner = 0;
+        size_t offset = 0;
+        size_t length = 0;
+        std::exception_ptr error;
+    };
+
+    struct Runner {
+        OutputBuffer output;
+        std::atomic<bool> done{false};
+    };
+
+    std::vector<Item> items;
+    std::unique_ptr<Runner[]> runners;
+
+public:
+    // render(out, json, parser) schrijft één document achteraan in out; een
+    // exception geldt alleen voor dat document. threads is het maximum aantal
+    // gelijktijdige runners, de aanroepende thread meegeteld.
+    template<typename Fn>
+    void run(const std::vector<std::string_view>& inputs, size_t threads, Fn&& render) {
+        items.assign(inputs.size(), Item{});
+        size_t runner_count = std::max<size_t>(1, std::min(threads, inputs.size()));
+        runners.reset(new Runner[runner_count]);
+        std::atomic<size_t> next{0};
+
+        auto runRunner = [&](size_t r) {
+            Runner& runner = runners[r];
+            ParserPool::Lease parser = ParserPool::acquire();
+            for (size_t i = next++; i < inputs.size(); i = next++) {
+                Item& item = items[i];
+                item.runner = r;
+                item.offset = runner.output.size();
+                try {
+                    render(runner.output, inputs[i], *parser);
+                } catch (...) {
+                    item.error = std::current_exception();
+                }
+                // Een mislukt document laat geen halve output achter
+                if (item.error) runner.output.truncate(item.offset);
+                item.length = runner.output.size() - item.offset;
+            }
+            runner.done.store(true, std::memory_order_release);
+        };
+
+        ThreadPool& pool = ThreadPool::shared();
+        for (size_t r = 1; r < runner_count; r++) {
+            pool.submit([&runRunner, r] { runRunner(r); });
+        }
+        runRunner(0);
+        pool.helpUntil([&] {
+            for (size_t r = 1; r < runner_count; r++) {
+                if (!runners[r].done.load(std::memory_order_acquire)) return false;
+            }
+            return true;
+        });
+    }
+
+    size_t size() const { return items.size(); }
+
+    // Geldig tot de volgende run
+    std::string_view result(size_t i) const {
+        const Item& item = items[i];
+        return runners[item.runner].output.view().substr(item.offset, item.length);
+    }
+
+    const std::exception_ptr& error(size_t i) const { return items[i].error; }
+};
+
+} // namespace colored_json
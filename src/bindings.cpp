@@ -4,12 +4,69 @@
 #include "printer.hpp"
 #include "html_printer.hpp"
 #include "markdown_printer.hpp"
+#include "py_output.hpp"
+#include "py_async.hpp"
+#include "token_tape.hpp"
+#include "batch_render.hpp"
 #include "style.hpp"
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace py = pybind11;
 
-PYBIND11_MODULE(colored_json, m) {
+namespace {
+
+// Style velden vanuit Python lezen en toewijzen onder de lock van de Style
+// (Style::locked, Style::modify), zodat een gelijktijdige snapshot() op een
+// andere thread een consistente kopie ziet.
+template<typename T>
+auto lockedGet(T colored_json::Style::* field) {
+    return [field](const colored_json::Style& s) { return s.locked([&] { return s.*field; }); };
+}
+
+template<typename T>
+auto lockedSet(T colored_json::Style::* field) {
+    return [field](colored_json::Style& s, const T& value) { s.modify([&] { s.*field = value; }); };
+}
+
+// Kleur van een Style (style.key_color): leest en schrijft het veld in de
+// Style zelf onder de lock, zodat style.key_color.bold = True blijft werken
+class StyleColorRef {
+    colored_json::Style* owner;
+    colored_json::Color colored_json::Style::* field;
+public:
+    StyleColorRef(colored_json::Style& s, colored_json::Color colored_json::Style::* f) : owner(&s), field(f) {}
+
+    colored_json::Color get() const { return owner->locked([&] { return owner->*field; }); }
+
+    template<typename T>
+    void set(T colored_json::Color::* member, T value) { owner->modify([&] { (owner->*field).*member = value; }); }
+};
+
+// Getter voor een kleur property; de StyleColor houdt zijn Style in leven
+auto colorRef(colored_json::Color colored_json::Style::* field) {
+    return py::cpp_function([field](colored_json::Style& s) { return StyleColorRef(s, field); },
+                            py::keep_alive<0, 1>());
+}
+
+template<typename T>
+auto refGet(T colored_json::Color::* member) {
+    return [member](const StyleColorRef& c) { return c.get().*member; };
+}
+
+template<typename T>
+auto refSet(T colored_json::Color::* member) {
+    return [member](StyleColorRef& c, T value) { c.set(member, value); };
+}
+
+} // namespace
+
+// Zonder GIL te gebruiken (free-threaded Python): renders lezen alleen een
+// snapshot van de Style en elke thread heeft zijn eigen parsers
+PYBIND11_MODULE(colored_json, m, py::mod_gil_not_used()) {
     // Register exception translator voor betere Python integratie
     py::register_exception_translator([](std::exception_ptr p) {
         try {
@@ -67,7 +124,9 @@ PYBIND11_MODULE(colored_json, m) {
         .value("BRACKET", colored_json::ElementType::Bracket, "Brackets [ ]")
         .value("COLON", colored_json::ElementType::Colon, "Dubbele punt :")
         .value("COMMA", colored_json::ElementType::Comma, "Komma ,")
-        .value("WHITESPACE", colored_json::ElementType::Whitespace, "Whitespace (indentatie)");
+        .value("WHITESPACE", colored_json::ElementType::Whitespace, "Whitespace (indentatie)")
+        .value("KEY_QUOTE", colored_json::ElementType::KeyQuote, "Aanhalingstekens rond keys")
+        .value("STRING_QUOTE", colored_json::ElementType::StringQuote, "Aanhalingstekens rond strings");
     
     py::class_<colored_json::Color>(m, "Color",
         R"doc(
@@ -128,7 +187,33 @@ PYBIND11_MODULE(colored_json, m) {
                         
                         Returns:
                             Color: Nieuwe Color instance
-                    )doc");
+                    )doc")
+        .def(py::init([](const StyleColorRef& c) { return c.get(); }), py::arg("color"),
+             "Kopieer de huidige waarde van een StyleColor naar een losse Color");
+    
+    py::class_<StyleColorRef>(m, "StyleColor",
+        R"doc(
+            Kleur van een Style, zoals teruggegeven door style.key_color.
+            
+            Heeft dezelfde attributen als Color, maar leest en schrijft direct
+            in de Style (onder de lock). Kan overal gebruikt worden waar een
+            Color verwacht wordt; colored_json.Color(style.key_color) geeft een
+            losse kopie.
+            
+            Voorbeelden:
+                >>> style.key_color.bold = True
+            )doc")
+        .def_property("r", refGet(&colored_json::Color::r), refSet(&colored_json::Color::r), "Rood component (0-255)")
+        .def_property("g", refGet(&colored_json::Color::g), refSet(&colored_json::Color::g), "Groen component (0-255)")
+        .def_property("b", refGet(&colored_json::Color::b), refSet(&colored_json::Color::b), "Blauw component (0-255)")
+        .def_property("bold", refGet(&colored_json::Color::bold), refSet(&colored_json::Color::bold), "Vetgedrukt tekst")
+        .def_property("italic", refGet(&colored_json::Color::italic), refSet(&colored_json::Color::italic), "Cursieve tekst")
+        .def_property("underline", refGet(&colored_json::Color::underline), refSet(&colored_json::Color::underline), "Onderstreepte tekst")
+        .def("to_ansi", [](const StyleColorRef& c, colored_json::ColorMode mode) { return c.get().toAnsi(mode); },
+             py::arg("mode") = colored_json::ColorMode::Auto,
+             "Converteer naar ANSI escape code string");
+    
+    py::implicitly_convertible<StyleColorRef, colored_json::Color>();
     
     py::class_<colored_json::Style>(m, "Style",
         R"doc(
@@ -155,6 +240,9 @@ PYBIND11_MODULE(colored_json, m) {
                 color_mode (ColorMode): Kleur modus voor ANSI conversie
                 compact (bool): Compact mode (geen indentatie)
                 indent_size (int): Aantal spaties per indent niveau
+                verbatim_strings (bool): JSON input strings ongewijzigd kopiëren
+                css_classes (bool): HTML/Markdown met CSS classes en één stylesheet
+                threads (int): Threads voor grote JSON documenten (0 = alle cores)
             
             Voorbeelden:
                 >>> style = colored_json.Style.get_preset("dracula")
@@ -166,35 +254,33 @@ PYBIND11_MODULE(colored_json, m) {
              R"doc(
                 Maak een nieuwe Style met standaard kleuren.
             )doc")
-        .def_readwrite("key_color", &colored_json::Style::key_color, 
-                       "Kleur voor dictionary keys")
-        .def_readwrite("string_color", &colored_json::Style::string_color, 
-                       "Kleur voor string waarden")
-        .def_readwrite("number_color", &colored_json::Style::number_color, 
-                       "Kleur voor numerieke waarden")
-        .def_readwrite("bool_color", &colored_json::Style::bool_color, 
-                       "Kleur voor boolean waarden")
-        .def_readwrite("null_color", &colored_json::Style::null_color, 
-                       "Kleur voor null waarden")
-        .def_readwrite("brace_color", &colored_json::Style::brace_color, 
-                       "Kleur voor accolades { }")
-        .def_readwrite("bracket_color", &colored_json::Style::bracket_color, 
-                       "Kleur voor brackets [ ]")
-        .def_readwrite("colon_color", &colored_json::Style::colon_color, 
-                       "Kleur voor dubbele punten :")
-        .def_readwrite("comma_color", &colored_json::Style::comma_color, 
-                       "Kleur voor komma's ,")
-        .def_readwrite("key_quote_color", &colored_json::Style::key_quote_color, 
-                       "Kleur voor aanhalingstekens rond keys")
-        .def_readwrite("string_quote_color", &colored_json::Style::string_quote_color, 
-                       "Kleur voor aanhalingstekens rond strings")
-        .def_property("key_colors", 
-            [](colored_json::Style& s) -> colored_json::KeyColorsMap& { return s.key_colors; },
-            [](colored_json::Style& s, const colored_json::KeyColorsMap& v) { s.key_colors = v; },
+        .def_property("key_color", colorRef(&colored_json::Style::key_color), lockedSet(&colored_json::Style::key_color),
+                      "Kleur voor dictionary keys")
+        .def_property("string_color", colorRef(&colored_json::Style::string_color), lockedSet(&colored_json::Style::string_color),
+                      "Kleur voor string waarden")
+        .def_property("number_color", colorRef(&colored_json::Style::number_color), lockedSet(&colored_json::Style::number_color),
+                      "Kleur voor numerieke waarden")
+        .def_property("bool_color", colorRef(&colored_json::Style::bool_color), lockedSet(&colored_json::Style::bool_color),
+                      "Kleur voor boolean waarden")
+        .def_property("null_color", colorRef(&colored_json::Style::null_color), lockedSet(&colored_json::Style::null_color),
+                      "Kleur voor null waarden")
+        .def_property("brace_color", colorRef(&colored_json::Style::brace_color), lockedSet(&colored_json::Style::brace_color),
+                      "Kleur voor accolades { }")
+        .def_property("bracket_color", colorRef(&colored_json::Style::bracket_color), lockedSet(&colored_json::Style::bracket_color),
+                      "Kleur voor brackets [ ]")
+        .def_property("colon_color", colorRef(&colored_json::Style::colon_color), lockedSet(&colored_json::Style::colon_color),
+                      "Kleur voor dubbele punten :")
+        .def_property("comma_color", colorRef(&colored_json::Style::comma_color), lockedSet(&colored_json::Style::comma_color),
+                      "Kleur voor komma's ,")
+        .def_property("key_quote_color", colorRef(&colored_json::Style::key_quote_color), lockedSet(&colored_json::Style::key_quote_color),
+                      "Kleur voor aanhalingstekens rond keys")
+        .def_property("string_quote_color", colorRef(&colored_json::Style::string_quote_color), lockedSet(&colored_json::Style::string_quote_color),
+                      "Kleur voor aanhalingstekens rond strings")
+        .def_property("key_colors",
+            lockedGet(&colored_json::Style::key_colors), lockedSet(&colored_json::Style::key_colors),
             "Dictionary voor individuele key kleuren (key -> Color)")
         .def_property("value_colors",
-            [](colored_json::Style& s) -> colored_json::ValueColorsMap& { return s.value_colors; },
-            [](colored_json::Style& s, const colored_json::ValueColorsMap& v) { s.value_colors = v; },
+            lockedGet(&colored_json::Style::value_colors), lockedSet(&colored_json::Style::value_colors),
             "Dictionary voor individuele value kleuren (path -> Color)")
         .def("set_key_color", &colored_json::Style::setKeyColor,
              py::arg("key"), py::arg("color"),
@@ -227,17 +313,27 @@ PYBIND11_MODULE(colored_json, m) {
                     - Eenvoudige keys: "user", "status"
                     - Geneste keys: "user.name", "user.age"
                     - Array items: "products[0].name", "products[1].price"
+                    - Wildcards: "products[*].price" (elke index), "*.id" (elke key)
+                
+                Het meest specifieke pad (meeste letterlijke segmenten) wint.
                 
                 Voorbeelden:
                     >>> style.set_value_color("user.name", colored_json.Color(255, 20, 147))
                     >>> style.set_value_color("products[0].price", colored_json.Color(255, 215, 0))
+                    >>> style.set_value_color("users[*].email", colored_json.colors.bright_cyan)
             )doc")
-        .def_readwrite("color_mode", &colored_json::Style::color_mode, 
-                       "Kleur modus voor ANSI conversie (ColorMode)")
-        .def_readwrite("compact", &colored_json::Style::compact, 
-                       "Compact mode: True = geen indentatie, False = geïndenteerd")
-        .def_readwrite("indent_size", &colored_json::Style::indent_size, 
-                       "Aantal spaties per indent niveau (standaard: 2)")
+        .def_property("color_mode", lockedGet(&colored_json::Style::color_mode), lockedSet(&colored_json::Style::color_mode),
+                      "Kleur modus voor ANSI conversie (ColorMode)")
+        .def_property("compact", lockedGet(&colored_json::Style::compact), lockedSet(&colored_json::Style::compact),
+                      "Compact mode: True = geen indentatie, False = geïndenteerd")
+        .def_property("indent_size", lockedGet(&colored_json::Style::indent_size), lockedSet(&colored_json::Style::indent_size),
+                      "Aantal spaties per indent niveau (standaard: 2)")
+        .def_property("verbatim_strings", lockedGet(&colored_json::Style::verbatim_strings), lockedSet(&colored_json::Style::verbatim_strings),
+                      "JSON input: strings en keys ongewijzigd (ge-escaped) uit de input kopiëren")
+        .def_property("css_classes", lockedGet(&colored_json::Style::css_classes), lockedSet(&colored_json::Style::css_classes),
+                      "HTML/Markdown: korte class per span plus één <style> blok in plaats van inline styles")
+        .def_property("threads", lockedGet(&colored_json::Style::threads), lockedSet(&colored_json::Style::threads),
+                      "Threads voor grote JSON documenten (root array of object): 0 = alle cores, 1 = sequentieel")
         .def_static("get_preset", &colored_json::Style::getPreset,
                     py::arg("name"),
                     R"doc(
@@ -272,6 +368,47 @@ PYBIND11_MODULE(colored_json, m) {
                             ['default', 'dracula', 'solarized', ...]
                     )doc");
     
+    // Helper functie voor dual mode: check of input JSON string is
+    auto isJsonString = [](py::handle obj) -> bool {
+        if (py::isinstance<py::str>(obj)) {
+            // Quick check: moet beginnen met { of [ (zonder de string te kopiëren)
+            if (PyUnicode_GET_LENGTH(obj.ptr()) > 0) {
+                Py_UCS4 first = PyUnicode_READ_CHAR(obj.ptr(), 0);
+                return first == '{' || first == '[';
+            }
+        }
+        return false;
+    };
+    
+    // JSON input voor dump, print_to en de async functies: een str die met
+    // { of [ begint, of bytes, bytearray of memoryview
+    auto isJsonInput = [isJsonString](py::handle obj) -> bool {
+        return isJsonString(obj) || PyObject_CheckBuffer(obj.ptr());
+    };
+    
+    // Streaming render naar een file descriptor of file object (dump,
+    // Printer.print_to); anders dan JSON input is obj een Python object
+    auto streamTo = [isJsonInput](colored_json::Printer& printer, py::handle obj,
+                                  py::handle file, size_t chunk_size) {
+        if (chunk_size == 0) {
+            throw py::value_error("chunk_size must be positive");
+        }
+        colored_json::PyOutputTarget target(file);
+        try {
+            colored_json::ScopedSink scoped(printer.buffer(), target.sink(), chunk_size);
+            if (isJsonInput(obj)) {
+                colored_json::JsonInput input(obj);
+                py::gil_scoped_release release;
+                printer.renderFromJson(input.view());
+            } else {
+                printer.render(obj);
+            }
+        } catch (...) {
+            target.rethrowError();
+            throw;
+        }
+    };
+    
     py::class_<colored_json::Printer>(m, "Printer",
         R"doc(
             Printer class voor console output met ANSI kleuren.
@@ -284,30 +421,72 @@ PYBIND11_MODULE(colored_json, m) {
                 >>> printer = colored_json.Printer(style)
                 >>> result = printer.print({"name": "Alice"})
             )doc")
-        .def(py::init<const colored_json::Style&>(),
+        .def(py::init<const colored_json::Style&, size_t>(),
              py::arg("style"),
+             py::arg("max_capacity") = 0,
+             py::keep_alive<1, 2>(),
              R"doc(
                 Maak een nieuwe Printer instance.
                 
+                De printer houdt zijn parser, output buffer en gecompileerde
+                Style vast tussen aanroepen. Hergebruik één printer per thread
+                voor veel kleine documenten.
+                
                 Args:
                     style: Style object voor kleuring en formatting
+                    max_capacity: Maximaal aantal bytes per buffer dat tussen
+                        aanroepen vastgehouden wordt (0 = geen limiet)
             )doc")
-        .def("print", &colored_json::Printer::print, 
+        .def_property("max_capacity", &colored_json::Printer::maxCapacity,
+                      &colored_json::Printer::setMaxCapacity,
+                      "Maximaal aantal bytes per buffer tussen aanroepen (0 = geen limiet)")
+        .def("print", [isJsonString](colored_json::Printer& self, py::handle obj) {
+            std::string_view result;
+            if (isJsonString(obj)) {
+                colored_json::JsonInput input(obj);
+                py::gil_scoped_release release;
+                result = self.renderFromJson(input.view());
+            } else {
+                result = self.render(obj);
+            }
+            py::str text = colored_json::toPyStr(result);
+            self.trim();
+            return text;
+        },
              py::arg("obj"),
              R"doc(
-                Formatteer en print een Python object.
+                Formatteer en print een Python object of JSON string.
                 
                 Args:
-                    obj: Python dict, list, of ander object om te formatteren
+                    obj: Python dict, list, JSON string, of ander object om te formatteren
                 
                 Returns:
                     str: Gekleurde string met ANSI escape codes
+            )doc")
+        .def("print_to", [streamTo](colored_json::Printer& self, py::handle obj, py::handle file,
+                                    size_t chunk_size) {
+            streamTo(self, obj, file, chunk_size);
+            self.trim();
+        },
+             py::arg("obj"), py::arg("file"), py::kw_only(), py::arg("chunk_size") = 64 * 1024,
+             R"doc(
+                Formatteer en schrijf in blokken naar een file descriptor of file object.
+                
+                Het geheugengebruik blijft begrensd, ook voor zeer grote
+                documenten. Naar een file descriptor wordt zonder GIL
+                geschreven; een file object krijgt elk blok via write()
+                (str voor tekstbestanden, anders bytes).
+                
+                Args:
+                    obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+                    file: File descriptor (int) of object met een write() methode
+                    chunk_size: Grootte van de blokken in bytes
             )doc");
     
     // Convenience functies
     m.def("print", [](py::handle obj, const colored_json::Style& style) {
         colored_json::Printer printer(style);
-        py::print(printer.print(obj));
+        py::print(colored_json::toPyStr(printer.render(obj)));
     }, py::arg("obj"), py::arg("style") = colored_json::Style{},
       R"doc(
         Print een Python object direct naar de console met kleuren.
@@ -325,32 +504,23 @@ PYBIND11_MODULE(colored_json, m) {
             >>> colored_json.print(data, style)
       )doc");
     
-    // Helper functie voor dual mode: check of input JSON string is
-    auto isJsonString = [](py::handle obj) -> bool {
-        if (py::isinstance<py::str>(obj)) {
-            std::string str_val = py::str(obj);
-            // Quick check: moet beginnen met { of [
-            if (!str_val.empty() && (str_val[0] == '{' || str_val[0] == '[')) {
-                return true;
-            }
-        }
-        return false;
-    };
-    
-    m.def("format", [isJsonString](py::handle obj, const colored_json::Style& style) {
+    m.def("format", [isJsonString](py::handle obj, const colored_json::Style& style,
+                                   bool as_bytes, py::handle into) {
         // Dual mode: check of input JSON string is
+        colored_json::Printer printer(style);
+        std::string_view result;
         if (isJsonString(obj)) {
             // JSON string path - release GIL voor snelle processing
-            std::string json_str = py::str(obj);
+            colored_json::JsonInput input(obj);
             py::gil_scoped_release release;
-            colored_json::Printer printer(style);
-            return printer.printFromJson(json_str);
+            result = printer.renderFromJson(input.view());
         } else {
             // Python object path (huidige implementatie)
-            colored_json::Printer printer(style);
-            return printer.print(obj);
+            result = printer.render(obj);
         }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("obj"), py::arg("style") = colored_json::Style{},
+      py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
       R"doc(
         Formatteer een Python object als gekleurde string.
         
@@ -360,6 +530,9 @@ PYBIND11_MODULE(colored_json, m) {
         Args:
             obj: Python dict, list, of ander object om te formatteren
             style: Optionele Style object (standaard: Style())
+            as_bytes: Resultaat als bytes in plaats van str
+            into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                de functie geeft dan het aantal geschreven bytes terug
         
         Returns:
             str: Gekleurde string met ANSI escape codes
@@ -375,12 +548,81 @@ PYBIND11_MODULE(colored_json, m) {
             >>> colored_json.format(json_str)
       )doc");
     
+    m.def("dump", [streamTo](py::handle obj, py::handle file, const colored_json::Style& style,
+                             size_t chunk_size) {
+        colored_json::Printer printer(style);
+        streamTo(printer, obj, file, chunk_size);
+    }, py::arg("obj"), py::arg("file"), py::arg("style") = colored_json::Style{},
+      py::kw_only(), py::arg("chunk_size") = 64 * 1024,
+      R"doc(
+        Formatteer een Python object of JSON en schrijf het in blokken weg.
+        
+        In tegenstelling tot format() wordt het resultaat nooit in zijn
+        geheel opgebouwd: de output gaat per blok van chunk_size bytes naar
+        file, dus het geheugengebruik blijft begrensd, ook voor een JSON
+        document van enkele GB's.
+        
+        Args:
+            obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+            file: File descriptor (int), zonder GIL beschreven, of een object
+                met een write() methode (str voor tekstbestanden, anders bytes)
+            style: Optionele Style object (standaard: Style())
+            chunk_size: Grootte van de blokken in bytes
+        
+        Voorbeelden:
+            >>> colored_json.dump(data, sys.stdout)
+            >>> with open("output.txt", "wb") as f:
+            ...     colored_json.dump(big_json_bytes, f.fileno())
+      )doc");
+    
+    m.def("format_async", [isJsonInput](py::handle obj, const colored_json::Style& style, bool as_bytes) {
+        colored_json::AsyncInput input(obj, isJsonInput(obj));
+        return colored_json::submitAsync(
+            [style = style.snapshot(), input = std::move(input),
+             printer = std::unique_ptr<colored_json::Printer>()]() mutable {
+                printer = std::make_unique<colored_json::Printer>(style);
+                return input.isJson() ? printer->renderFromJson(input.json())
+                                      : printer->renderSnapshot(input.snapshot());
+            }, as_bytes);
+    }, py::arg("obj"), py::arg("style") = colored_json::Style{},
+      py::kw_only(), py::arg("as_bytes") = false,
+      R"doc(
+        Formatteer een Python object of JSON zonder de event loop te blokkeren.
+        
+        Het renderen gebeurt zonder GIL op de async thread pool van de module; de
+        returnwaarde is een asyncio future van de lopende event loop. Een
+        Python object wordt eerst (met de GIL) gekopieerd, JSON als str,
+        bytes, bytearray of memoryview wordt zonder kopie gelezen. De Style
+        wordt bij de aanroep gekopieerd.
+        
+        Args:
+            obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+            style: Optionele Style object (standaard: Style())
+            as_bytes: Resultaat als bytes in plaats van str
+        
+        Returns:
+            asyncio.Future: Gekleurde string met ANSI escape codes
+        
+        Voorbeelden:
+            >>> text = await colored_json.format_async(await request.read(), style)
+      )doc");
+    
+    // Lopende async renders afronden voordat de interpreter afsluit
+    py::module_::import("atexit").attr("register")(py::cpp_function(&colored_json::waitForAsyncJobs));
+    
     // Expliciete functie voor JSON strings
-    m.def("format_from_json", [](const std::string& json_str, const colored_json::Style& style) {
-        py::gil_scoped_release release;
+    m.def("format_from_json", [](py::handle json_str, const colored_json::Style& style,
+                                 bool as_bytes, py::handle into) {
         colored_json::Printer printer(style);
-        return printer.printFromJson(json_str);
+        colored_json::JsonInput input(json_str);
+        std::string_view result;
+        {
+            py::gil_scoped_release release;
+            result = printer.renderFromJson(input.view());
+        }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("json_str"), py::arg("style") = colored_json::Style{},
+      py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
       R"doc(
         Formatteer een JSON string als gekleurde string (expliciete functie).
         
@@ -389,8 +631,11 @@ PYBIND11_MODULE(colored_json, m) {
         processing voor betere multi-threaded performance.
         
         Args:
-            json_str: JSON string om te formatteren
+            json_str: JSON als str, bytes, bytearray of memoryview
             style: Optionele Style object (standaard: Style())
+            as_bytes: Resultaat als bytes in plaats van str
+            into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                de functie geeft dan het aantal geschreven bytes terug
         
         Returns:
             str: Gekleurde string met ANSI escape codes
@@ -415,25 +660,40 @@ PYBIND11_MODULE(colored_json, m) {
                 >>> printer = colored_json.HtmlPrinter(style)
                 >>> html = printer.print(data, title="My JSON", background_color="#282a36")
             )doc")
-        .def(py::init<const colored_json::Style&>(),
+        .def(py::init<const colored_json::Style&, size_t>(),
              py::arg("style"),
+             py::arg("max_capacity") = 0,
+             py::keep_alive<1, 2>(),
              R"doc(
                 Maak een nieuwe HtmlPrinter instance.
                 
+                De printer houdt zijn parser, output buffer en gecompileerde
+                Style vast tussen aanroepen. Hergebruik één printer per thread
+                voor veel kleine documenten.
+                
                 Args:
                     style: Style object voor kleuring en formatting
+                    max_capacity: Maximaal aantal bytes per buffer dat tussen
+                        aanroepen vastgehouden wordt (0 = geen limiet)
             )doc")
+        .def_property("max_capacity", &colored_json::HtmlPrinter::maxCapacity,
+                      &colored_json::HtmlPrinter::setMaxCapacity,
+                      "Maximaal aantal bytes per buffer tussen aanroepen (0 = geen limiet)")
         .def("print", [isJsonString](colored_json::HtmlPrinter& self, py::handle obj,
                                      const std::string& title,
                                      const std::string& background_color,
                                      const std::string& font_family) {
+            std::string_view result;
             if (isJsonString(obj)) {
-                std::string json_str = py::str(obj);
+                colored_json::JsonInput input(obj);
                 py::gil_scoped_release release;
-                return self.printFromJson(json_str, title, background_color, font_family);
+                result = self.renderFromJson(input.view(), title, background_color, font_family);
             } else {
-                return self.print(obj, title, background_color, font_family);
+                result = self.render(obj, title, background_color, font_family);
             }
+            py::str text = colored_json::toPyStr(result);
+            self.trim();
+            return text;
         },
              py::arg("obj"),
              py::arg("title") = "Colored JSON",
@@ -455,20 +715,24 @@ PYBIND11_MODULE(colored_json, m) {
     m.def("to_html", [isJsonString](py::handle obj, const colored_json::Style& style,
                         const std::string& title,
                         const std::string& background_color,
-                        const std::string& font_family) {
+                        const std::string& font_family,
+                        bool as_bytes, py::handle into) {
         colored_json::HtmlPrinter printer(style);
+        std::string_view result;
         if (isJsonString(obj)) {
-            std::string json_str = py::str(obj);
+            colored_json::JsonInput input(obj);
             py::gil_scoped_release release;
-            return printer.printFromJson(json_str, title, background_color, font_family);
+            result = printer.renderFromJson(input.view(), title, background_color, font_family);
         } else {
-            return printer.print(obj, title, background_color, font_family);
+            result = printer.render(obj, title, background_color, font_family);
         }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("obj"),
         py::arg("style") = colored_json::Style{},
         py::arg("title") = "Colored JSON",
         py::arg("background_color") = "#1e1e1e",
         py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
         R"doc(
             Genereer HTML output van gekleurde JSON (convenience functie).
             
@@ -481,6 +745,9 @@ PYBIND11_MODULE(colored_json, m) {
                 title: Titel voor de HTML pagina
                 background_color: Achtergrondkleur (CSS kleur string, bijv. "#1e1e1e")
                 font_family: Font familie voor de JSON weergave
+                as_bytes: Resultaat als bytes in plaats van str
+                into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                    de functie geeft dan het aantal geschreven bytes terug
             
             Returns:
                 str: Complete HTML string met inline styles
@@ -495,30 +762,82 @@ PYBIND11_MODULE(colored_json, m) {
             >>> html = colored_json.to_html(json_str, style)
         )doc");
     
+    m.def("to_html_async", [isJsonInput](py::handle obj, const colored_json::Style& style,
+                                         const std::string& title,
+                                         const std::string& background_color,
+                                         const std::string& font_family,
+                                         bool as_bytes) {
+        colored_json::AsyncInput input(obj, isJsonInput(obj));
+        return colored_json::submitAsync(
+            [style = style.snapshot(), input = std::move(input),
+             title, background_color, font_family,
+             printer = std::unique_ptr<colored_json::HtmlPrinter>()]() mutable {
+                printer = std::make_unique<colored_json::HtmlPrinter>(style);
+                return input.isJson()
+                    ? printer->renderFromJson(input.json(), title, background_color, font_family)
+                    : printer->renderSnapshot(input.snapshot(), title, background_color, font_family);
+            }, as_bytes);
+    }, py::arg("obj"),
+        py::arg("style") = colored_json::Style{},
+        py::arg("title") = "Colored JSON",
+        py::arg("background_color") = "#1e1e1e",
+        py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        py::kw_only(), py::arg("as_bytes") = false,
+        R"doc(
+            Genereer HTML output zonder de event loop te blokkeren.
+            
+            Als to_html(), maar het renderen gebeurt zonder GIL op de thread
+            pool van de module (zie format_async()).
+            
+            Args:
+                obj: Python object, JSON string of JSON bytes/bytearray/memoryview
+                style: Optionele Style object (standaard: Style())
+                title: Titel voor de HTML pagina
+                background_color: Achtergrondkleur (CSS kleur string, bijv. "#1e1e1e")
+                font_family: Font familie voor de JSON weergave
+                as_bytes: Resultaat als bytes in plaats van str
+            
+            Returns:
+                asyncio.Future: Complete HTML string met inline styles
+            
+            Voorbeelden:
+                >>> html = await colored_json.to_html_async(payload, style, title="Debug")
+        )doc");
+    
     // Expliciete functie voor JSON strings
-    m.def("to_html_from_json", [](const std::string& json_str, const colored_json::Style& style,
+    m.def("to_html_from_json", [](py::handle json_str, const colored_json::Style& style,
                                   const std::string& title,
                                   const std::string& background_color,
-                                  const std::string& font_family) {
-        py::gil_scoped_release release;
+                                  const std::string& font_family,
+                                  bool as_bytes, py::handle into) {
         colored_json::HtmlPrinter printer(style);
-        return printer.printFromJson(json_str, title, background_color, font_family);
+        colored_json::JsonInput input(json_str);
+        std::string_view result;
+        {
+            py::gil_scoped_release release;
+            result = printer.renderFromJson(input.view(), title, background_color, font_family);
+        }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("json_str"),
         py::arg("style") = colored_json::Style{},
         py::arg("title") = "Colored JSON",
         py::arg("background_color") = "#1e1e1e",
         py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
         R"doc(
             Genereer HTML output van JSON string (expliciete functie).
             
             Geoptimaliseerd voor JSON string input met simdjson en GIL release.
             
             Args:
-                json_str: JSON string om te formatteren
+                json_str: JSON als str, bytes, bytearray of memoryview
                 style: Optionele Style object (standaard: Style())
                 title: Titel voor de HTML pagina
                 background_color: Achtergrondkleur (CSS kleur string)
                 font_family: Font familie voor de JSON weergave
+                as_bytes: Resultaat als bytes in plaats van str
+                into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                    de functie geeft dan het aantal geschreven bytes terug
             
             Returns:
                 str: Complete HTML string met inline styles
@@ -542,24 +861,39 @@ PYBIND11_MODULE(colored_json, m) {
                 >>> printer = colored_json.MarkdownPrinter(style)
                 >>> md = printer.print(data, title="Example")
             )doc")
-        .def(py::init<const colored_json::Style&>(),
+        .def(py::init<const colored_json::Style&, size_t>(),
              py::arg("style"),
+             py::arg("max_capacity") = 0,
+             py::keep_alive<1, 2>(),
              R"doc(
                 Maak een nieuwe MarkdownPrinter instance.
                 
+                De printer houdt zijn parser, output buffer en gecompileerde
+                Style vast tussen aanroepen. Hergebruik één printer per thread
+                voor veel kleine documenten.
+                
                 Args:
                     style: Style object voor kleuring en formatting
+                    max_capacity: Maximaal aantal bytes per buffer dat tussen
+                        aanroepen vastgehouden wordt (0 = geen limiet)
             )doc")
+        .def_property("max_capacity", &colored_json::MarkdownPrinter::maxCapacity,
+                      &colored_json::MarkdownPrinter::setMaxCapacity,
+                      "Maximaal aantal bytes per buffer tussen aanroepen (0 = geen limiet)")
         .def("print", [isJsonString](colored_json::MarkdownPrinter& self, py::handle obj,
                                      const std::string& title,
                                      const std::string& language) {
+            std::string_view result;
             if (isJsonString(obj)) {
-                std::string json_str = py::str(obj);
+                colored_json::JsonInput input(obj);
                 py::gil_scoped_release release;
-                return self.printFromJson(json_str, title, language);
+                result = self.renderFromJson(input.view(), title, language);
             } else {
-                return self.print(obj, title, language);
+                result = self.render(obj, title, language);
             }
+            py::str text = colored_json::toPyStr(result);
+            self.trim();
+            return text;
         },
              py::arg("obj"),
              py::arg("title") = "Colored JSON",
@@ -582,13 +916,17 @@ PYBIND11_MODULE(colored_json, m) {
                                           const std::string& title,
                                           const std::string& background_color,
                                           const std::string& font_family) {
+            std::string_view result;
             if (isJsonString(obj)) {
-                std::string json_str = py::str(obj);
+                colored_json::JsonInput input(obj);
                 py::gil_scoped_release release;
-                return self.printHtmlFromJson(json_str, title, background_color, font_family);
+                result = self.renderHtmlFromJson(input.view(), title, background_color, font_family);
             } else {
-                return self.printHtml(obj, title, background_color, font_family);
+                result = self.renderHtml(obj, title, background_color, font_family);
             }
+            py::str text = colored_json::toPyStr(result);
+            self.trim();
+            return text;
         },
              py::arg("obj"),
              py::arg("title") = "Colored JSON",
@@ -612,19 +950,23 @@ PYBIND11_MODULE(colored_json, m) {
     
     m.def("to_markdown", [isJsonString](py::handle obj, const colored_json::Style& style,
                            const std::string& title,
-                           const std::string& language) {
+                           const std::string& language,
+                           bool as_bytes, py::handle into) {
         colored_json::MarkdownPrinter printer(style);
+        std::string_view result;
         if (isJsonString(obj)) {
-            std::string json_str = py::str(obj);
+            colored_json::JsonInput input(obj);
             py::gil_scoped_release release;
-            return printer.printFromJson(json_str, title, language);
+            result = printer.renderFromJson(input.view(), title, language);
         } else {
-            return printer.print(obj, title, language);
+            result = printer.render(obj, title, language);
         }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("obj"),
         py::arg("style") = colored_json::Style{},
         py::arg("title") = "Colored JSON",
         py::arg("language") = "json",
+        py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
         R"doc(
             Genereer Markdown output met code block (convenience functie).
             
@@ -636,6 +978,9 @@ PYBIND11_MODULE(colored_json, m) {
                 style: Optionele Style object (standaard: Style())
                 title: Titel voor de Markdown sectie
                 language: Code block language identifier (standaard: "json")
+                as_bytes: Resultaat als bytes in plaats van str
+                into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                    de functie geeft dan het aantal geschreven bytes terug
             
             Returns:
                 str: Markdown string met code block
@@ -651,26 +996,36 @@ PYBIND11_MODULE(colored_json, m) {
         )doc");
     
     // Expliciete functie voor JSON strings
-    m.def("to_markdown_from_json", [](const std::string& json_str, const colored_json::Style& style,
+    m.def("to_markdown_from_json", [](py::handle json_str, const colored_json::Style& style,
                                      const std::string& title,
-                                     const std::string& language) {
-        py::gil_scoped_release release;
+                                     const std::string& language,
+                                     bool as_bytes, py::handle into) {
         colored_json::MarkdownPrinter printer(style);
-        return printer.printFromJson(json_str, title, language);
+        colored_json::JsonInput input(json_str);
+        std::string_view result;
+        {
+            py::gil_scoped_release release;
+            result = printer.renderFromJson(input.view(), title, language);
+        }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("json_str"),
         py::arg("style") = colored_json::Style{},
         py::arg("title") = "Colored JSON",
         py::arg("language") = "json",
+        py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
         R"doc(
             Genereer Markdown output van JSON string (expliciete functie).
             
             Geoptimaliseerd voor JSON string input met simdjson en GIL release.
             
             Args:
-                json_str: JSON string om te formatteren
+                json_str: JSON als str, bytes, bytearray of memoryview
                 style: Optionele Style object (standaard: Style())
                 title: Titel voor de Markdown sectie
                 language: Code block language identifier (standaard: "json")
+                as_bytes: Resultaat als bytes in plaats van str
+                into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                    de functie geeft dan het aantal geschreven bytes terug
             
             Returns:
                 str: Markdown string met code block
@@ -683,20 +1038,24 @@ PYBIND11_MODULE(colored_json, m) {
     m.def("to_markdown_html", [isJsonString](py::handle obj, const colored_json::Style& style,
                                  const std::string& title,
                                  const std::string& background_color,
-                                 const std::string& font_family) {
+                                 const std::string& font_family,
+                                 bool as_bytes, py::handle into) {
         colored_json::MarkdownPrinter printer(style);
+        std::string_view result;
         if (isJsonString(obj)) {
-            std::string json_str = py::str(obj);
+            colored_json::JsonInput input(obj);
             py::gil_scoped_release release;
-            return printer.printHtmlFromJson(json_str, title, background_color, font_family);
+            result = printer.renderHtmlFromJson(input.view(), title, background_color, font_family);
         } else {
-            return printer.printHtml(obj, title, background_color, font_family);
+            result = printer.renderHtml(obj, title, background_color, font_family);
         }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("obj"),
         py::arg("style") = colored_json::Style{},
         py::arg("title") = "Colored JSON",
         py::arg("background_color") = "#1e1e1e",
         py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
         R"doc(
             Genereer Markdown met HTML code block voor gekleurde JSON (convenience functie).
             
@@ -709,6 +1068,9 @@ PYBIND11_MODULE(colored_json, m) {
                 title: Titel voor de Markdown sectie
                 background_color: Achtergrondkleur (CSS kleur string, bijv. "#1e1e1e")
                 font_family: Font familie voor de JSON weergave
+                as_bytes: Resultaat als bytes in plaats van str
+                into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                    de functie geeft dan het aantal geschreven bytes terug
             
             Returns:
                 str: Markdown string met HTML code block
@@ -724,29 +1086,39 @@ PYBIND11_MODULE(colored_json, m) {
         )doc");
     
     // Expliciete functie voor JSON strings
-    m.def("to_markdown_html_from_json", [](const std::string& json_str, const colored_json::Style& style,
+    m.def("to_markdown_html_from_json", [](py::handle json_str, const colored_json::Style& style,
                                             const std::string& title,
                                             const std::string& background_color,
-                                            const std::string& font_family) {
-        py::gil_scoped_release release;
+                                            const std::string& font_family,
+                                            bool as_bytes, py::handle into) {
         colored_json::MarkdownPrinter printer(style);
-        return printer.printHtmlFromJson(json_str, title, background_color, font_family);
+        colored_json::JsonInput input(json_str);
+        std::string_view result;
+        {
+            py::gil_scoped_release release;
+            result = printer.renderHtmlFromJson(input.view(), title, background_color, font_family);
+        }
+        return colored_json::toPyResult(result, as_bytes, into);
     }, py::arg("json_str"),
         py::arg("style") = colored_json::Style{},
         py::arg("title") = "Colored JSON",
         py::arg("background_color") = "#1e1e1e",
         py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        py::kw_only(), py::arg("as_bytes") = false, py::arg("into") = py::none(),
         R"doc(
             Genereer Markdown met HTML code block van JSON string (expliciete functie).
             
             Geoptimaliseerd voor JSON string input met simdjson en GIL release.
             
             Args:
-                json_str: JSON string om te formatteren
+                json_str: JSON als str, bytes, bytearray of memoryview
                 style: Optionele Style object (standaard: Style())
                 title: Titel voor de Markdown sectie
                 background_color: Achtergrondkleur (CSS kleur string)
                 font_family: Font familie voor de JSON weergave
+                as_bytes: Resultaat als bytes in plaats van str
+                into: Schrijfbare buffer (bytearray, memoryview) voor het resultaat;
+                    de functie geeft dan het aantal geschreven bytes terug
             
             Returns:
                 str: Markdown string met HTML code block
@@ -756,6 +1128,208 @@ PYBIND11_MODULE(colored_json, m) {
                 >>> md = colored_json.to_markdown_html_from_json(json_str, style)
         )doc");
     
+    // Meerdere formaten uit één parse: het document wordt één keer als token
+    // tape opgenomen en daarna per formaat zonder GIL gerenderd
+    m.def("render_formats", [isJsonString](py::handle obj, const colored_json::Style& style,
+                               const std::vector<std::string>& formats,
+                               const std::string& title,
+                               const std::string& background_color,
+                               const std::string& font_family,
+                               const std::string& language) {
+        static const char* const FORMAT_NAMES[] = {"ansi", "html", "markdown", "markdown_html"};
+        std::vector<size_t> requested;
+        for (const auto& format : formats) {
+            size_t index = 0;
+            while (index < 4 && format != FORMAT_NAMES[index]) index++;
+            if (index == 4) {
+                throw std::runtime_error("Unknown format: " + format);
+            }
+            requested.push_back(index);
+        }
+        
+        // De tape en alle printers gebruiken dezelfde snapshot van de Style
+        std::shared_ptr<const colored_json::Style> frozen = style.snapshot();
+        colored_json::TokenTape tape;
+        if (isJsonString(obj)) {
+            colored_json::JsonInput input(obj);
+            py::gil_scoped_release release;
+            tape = colored_json::TokenTape::fromJson(input.view(), *frozen);
+        } else {
+            tape = colored_json::tapeFromPython(obj, *frozen);
+        }
+        
+        // Eén printer per formaat, zodat alle views tegelijk geldig blijven
+        colored_json::Printer ansi(frozen);
+        colored_json::HtmlPrinter html(frozen);
+        colored_json::MarkdownPrinter markdown(frozen);
+        colored_json::MarkdownPrinter markdown_html(frozen);
+        std::string_view results[4];
+        bool rendered[4] = {false, false, false, false};
+        {
+            py::gil_scoped_release release;
+            for (size_t index : requested) {
+                if (rendered[index]) continue;
+                switch (index) {
+                    case 0: results[0] = ansi.renderTape(tape); break;
+                    case 1: results[1] = html.renderTape(tape, title, background_color, font_family); break;
+                    case 2: results[2] = markdown.renderTape(tape, title, language); break;
+                    default: results[3] = markdown_html.renderHtmlTape(tape, title, background_color, font_family); break;
+                }
+                rendered[index] = true;
+            }
+        }
+        
+        py::dict out;
+        for (size_t index : requested) {
+            out[py::str(FORMAT_NAMES[index])] = colored_json::toPyStr(results[index]);
+        }
+        return out;
+    }, py::arg("obj"),
+        py::arg("style") = colored_json::Style{},
+        py::arg("formats") = std::vector<std::string>{"ansi", "html", "markdown"},
+        py::arg("title") = "Colored JSON",
+        py::arg("background_color") = "#1e1e1e",
+        py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        py::arg("language") = "json",
+        R"doc(
+            Render een object of JSON string naar meerdere formaten uit één parse.
+            
+            Het document wordt één keer doorlopen (inclusief key/value regels) en
+            als token tape opgeslagen; elk formaat wordt daarna uit de tape
+            gerenderd. De output is gelijk aan die van format, to_html,
+            to_markdown en to_markdown_html.
+            
+            Args:
+                obj: Python dict, list, of JSON string
+                style: Optionele Style object (standaard: Style())
+                formats: Lijst met "ansi", "html", "markdown" en/of "markdown_html"
+                title: Titel voor HTML en Markdown
+                background_color: Achtergrondkleur voor HTML en markdown_html
+                font_family: Font familie voor HTML en markdown_html
+                language: Taal voor het Markdown code block
+            
+            Returns:
+                dict: Formaat naam -> gerenderde string
+            
+            Voorbeelden:
+                >>> out = colored_json.render_formats(data, style, ["ansi", "html"])
+                >>> print(out["ansi"])
+                >>> open("data.html", "w", encoding="utf-8").write(out["html"])
+        )doc");
+    
+    // Veel losse JSON documenten in één aanroep: de GIL wordt één keer
+    // vrijgegeven en de documenten worden verdeeld over native threads
+    auto collectInputs = [](const py::sequence& inputs, std::vector<colored_json::JsonInput>& keep,
+                            std::vector<std::string_view>& views) {
+        keep.reserve(inputs.size());
+        views.reserve(inputs.size());
+        for (py::handle item : inputs) {
+            keep.emplace_back(item);
+            views.push_back(keep.back().view());
+        }
+    };
+    auto collectResults = [](const colored_json::BatchRenderer& batch) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (!batch.error(i)) continue;
+            try {
+                std::rethrow_exception(batch.error(i));
+            } catch (const std::exception& e) {
+                throw std::runtime_error("Input " + std::to_string(i) + ": " + e.what());
+            }
+        }
+        py::list out(batch.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            out[i] = colored_json::toPyStr(batch.result(i));
+        }
+        return out;
+    };
+    
+    m.def("format_many", [collectInputs, collectResults](const py::sequence& inputs,
+                                                          const colored_json::Style& style, int threads) {
+        std::vector<colored_json::JsonInput> keep;
+        std::vector<std::string_view> views;
+        collectInputs(inputs, keep, views);
+        std::shared_ptr<const colored_json::Style> frozen = style.snapshot();
+        colored_json::BatchRenderer batch;
+        {
+            py::gil_scoped_release release;
+            colored_json::CompiledStyle compiled = colored_json::CompiledStyle::ansi(*frozen);
+            batch.run(views, colored_json::resolveThreadCount(threads),
+                      [&](colored_json::OutputBuffer& out, std::string_view json,
+                          simdjson::ondemand::parser& parser) {
+                colored_json::appendAnsiJson(out, *frozen, compiled, json, parser, 1);
+            });
+        }
+        return collectResults(batch);
+    }, py::arg("inputs"), py::arg("style") = colored_json::Style{}, py::arg("threads") = 0,
+      R"doc(
+        Formatteer een lijst JSON strings in één aanroep.
+        
+        De GIL wordt één keer vrijgegeven; de documenten worden over native
+        threads verdeeld en elke thread hergebruikt één parser en één buffer.
+        Het resultaat is gelijk aan format_from_json per document.
+        
+        Args:
+            inputs: Lijst (of andere sequence) van str, bytes, bytearray of memoryview met JSON
+            style: Optionele Style object (standaard: Style())
+            threads: Aantal threads (0 = alle cores)
+        
+        Returns:
+            list[str]: Gekleurde strings, in dezelfde volgorde als inputs
+        
+        Raises:
+            RuntimeError: Bij ongeldige JSON, met de index van het document
+        
+        Voorbeelden:
+            >>> lines = open("log.jsonl", encoding="utf-8").read().splitlines()
+            >>> colored = colored_json.format_many(lines, style, threads=4)
+      )doc");
+    
+    m.def("to_html_many", [collectInputs, collectResults](const py::sequence& inputs,
+                                                           const colored_json::Style& style, int threads,
+                                                           const std::string& title,
+                                                           const std::string& background_color,
+                                                           const std::string& font_family) {
+        std::vector<colored_json::JsonInput> keep;
+        std::vector<std::string_view> views;
+        collectInputs(inputs, keep, views);
+        std::shared_ptr<const colored_json::Style> frozen = style.snapshot();
+        colored_json::BatchRenderer batch;
+        {
+            py::gil_scoped_release release;
+            colored_json::CompiledStyle compiled = colored_json::CompiledStyle::html(*frozen);
+            batch.run(views, colored_json::resolveThreadCount(threads),
+                      [&](colored_json::OutputBuffer& out, std::string_view json,
+                          simdjson::ondemand::parser& parser) {
+                colored_json::appendHtmlJson(out, *frozen, compiled, json, parser, 1,
+                                             title, background_color, font_family);
+            });
+        }
+        return collectResults(batch);
+    }, py::arg("inputs"),
+        py::arg("style") = colored_json::Style{},
+        py::arg("threads") = 0,
+        py::arg("title") = "Colored JSON",
+        py::arg("background_color") = "#1e1e1e",
+        py::arg("font_family") = "Consolas, 'Courier New', monospace",
+        R"doc(
+            Genereer HTML output voor een lijst JSON strings in één aanroep.
+            
+            Zoals format_many, met per document een volledige HTML pagina gelijk
+            aan to_html_from_json.
+            
+            Args:
+                inputs: Lijst (of andere sequence) van str, bytes, bytearray of memoryview met JSON
+                style: Optionele Style object (standaard: Style())
+                threads: Aantal threads (0 = alle cores)
+                title: Titel voor de HTML pagina's
+                background_color: Achtergrondkleur (CSS kleur string)
+                font_family: Font familie voor de JSON weergave
+            
+            Returns:
+                list[str]: HTML strings, in dezelfde volgorde als inputs
+        )doc");
+    
     // Expose builtin colors
     py::module_ colors = m.def_submodule("colors", 
         R"doc(
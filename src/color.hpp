@@ -25,24 +25,34 @@ struct Color {
     
     std::string toAnsi(ColorMode mode = ColorMode::Auto) const;
     static Color fromRgb(uint8_t r, uint8_t g, uint8_t b) { return {r, g, b}; }
+    
+    bool operator==(const Color& o) const {
+        return r == o.r && g == o.g && b == o.b && bold == o.bold && italic == o.italic && underline == o.underline;
+    }
+    bool operator!=(const Color& o) const { return !(*this == o); }
 };
 
+// Zet ColorMode::Auto om naar een concrete modus op basis van de terminal.
+// Leest TERM/COLORTERM, dus eenmalig per render aanroepen en niet per token.
+inline ColorMode resolveColorMode(ColorMode mode) {
+    if (mode != ColorMode::Auto) return mode;
+    
+    const char* term = std::getenv("TERM");
+    const char* colorterm = std::getenv("COLORTERM");
+    
+    if (colorterm && std::string(colorterm) == "truecolor") {
+        return ColorMode::TrueColor;
+    } else if (term && std::string(term).find("256") != std::string::npos) {
+        return ColorMode::Ansi256;
+    }
+    return ColorMode::Ansi16;
+}
+
 inline std::string Color::toAnsi(ColorMode mode) const {
     if (mode == ColorMode::Disabled) return "";
     
     // Auto-detectie
-    if (mode == ColorMode::Auto) {
-        const char* term = std::getenv("TERM");
-        const char* colorterm = std::getenv("COLORTERM");
-        
-        if (colorterm && std::string(colorterm) == "truecolor") {
-            mode = ColorMode::TrueColor;
-        } else if (term && std::string(term).find("256") != std::string::npos) {
-            mode = ColorMode::Ansi256;
-        } else {
-            mode = ColorMode::Ansi16;
-        }
-    }
+    mode = resolveColorMode(mode);
     
     std::stringstream ss;
     ss << "\033[";
@@ -0,0 +1,301 @@
+#pragma once
+#include "style.hpp"
+#include "path_matcher.hpp"
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace colored_json {
+
+constexpr ColorSlot slotOf(ElementType type) {
+    return static_cast<ColorSlot>(type);
+}
+
+// CSS kleur als rgb(r,g,b) (HTML export)
+inline std::string colorToCss(const Color& color) {
+    std::stringstream css;
+    css << "rgb(" << static_cast<int>(color.r) << ","
+        << static_cast<int>(color.g) << ","
+        << static_cast<int>(color.b) << ")";
+    return css.str();
+}
+
+// CSS kleur als #rrggbb (Markdown export)
+inline std::string colorToHex(const Color& color) {
+    std::stringstream hex;
+    hex << "#" << std::hex << std::setfill('0') << std::setw(2)
+        << static_cast<int>(color.r) << std::setw(2)
+        << static_cast<int>(color.g) << std::setw(2)
+        << static_cast<int>(color.b);
+    return hex.str();
+}
+
+// CSS declaraties voor een kleur inclusief bold/italic/underline
+inline std::string cssDeclarations(const Color& color, const std::string& css_color) {
+    std::string decl = "color: " + css_color;
+    if (color.bold) decl += "; font-weight: bold";
+    if (color.italic) decl += "; font-style: italic";
+    if (color.underline) decl += "; text-decoration: underline";
+    return decl;
+}
+
+// Korte CSS class per slot voor Style::css_classes: vaste namen per
+// ElementType, daarna k0, k1, ... (key kleuren) en v0, v1, ... (value kleuren)
+inline std::string cssClassName(ColorSlot slot, size_t key_color_count) {
+    static constexpr const char* ELEMENT_CLASSES[ELEMENT_TYPE_COUNT] = {
+        "k", "s", "n", "b", "nl", "br", "bk", "cl", "cm", "ws", "kq", "sq"
+    };
+    if (slot < ELEMENT_TYPE_COUNT) return ELEMENT_CLASSES[slot];
+    size_t index = slot - ELEMENT_TYPE_COUNT;
+    if (index < key_color_count) return "k" + std::to_string(index);
+    return "v" + std::to_string(index - key_color_count);
+}
+
+// Vaste structurele stukken van de output, vooraf gerenderd met kleur
+enum class Fragment {
+    OpenBrace,
+    CloseBrace,
+    EmptyBrace,    // {}
+    OpenBracket,
+    CloseBracket,
+    EmptyBracket,  // []
+    Separator,     // , plus (pretty) newline en indent
+    Colon,         // : plus (pretty) spatie
+    KeyQuote,
+    StringQuote
+};
+
+constexpr size_t FRAGMENT_COUNT = static_cast<size_t>(Fragment::StringQuote) + 1;
+
+// Een fragment in drie varianten, afhankelijk van de actieve kleur: kleur al
+// actief, kleur openen, of eerst resetten (of de open <span> sluiten) en dan
+// openen
+struct FragmentBytes {
+    std::string variants[3];
+    ColorSlot run = NO_SLOT;    // Kleur van het fragment
+    ColorSlot after = NO_SLOT;  // Actieve kleur na het fragment
+    size_t slab_spaces = 0;     // Indent spaties aan het einde (Separator)
+};
+
+// Style met alle kleuren vooraf omgezet naar de bytes die de printer schrijft.
+// Eén vlakke tabel met per slot de openingssequentie (ANSI escape of
+// <span ...>), plus één afsluitende sequentie. Wordt eenmalig per render
+// gebouwd zodat er per token alleen nog een tabel lookup nodig is.
+class CompiledStyle {
+public:
+    // Aantal indent niveaus in de vooraf gerenderde slabs; dieper wordt aangevuld
+    static constexpr size_t SLAB_LEVELS = 32;
+
+private:
+    // Terminal toestand die een slot achterlaat (voor het samenvoegen van runs)
+    struct SlotRun {
+        ColorSlot run = NO_SLOT;  // Eerste slot met dezelfde open bytes; NO_SLOT = geen kleur
+        bool attributes = false;  // bold/italic/underline blijven staan na een nieuwe kleur
+        bool underline = false;   // Zichtbaar op whitespace
+    };
+
+    std::vector<std::string> table;
+    std::vector<SlotRun> runs;
+    std::string close_seq;
+    bool colored = false;  // Minstens één slot met een escape (niet bij ColorMode::Disabled)
+    bool markup = false;   // Runs zijn <span> elementen (HTML/Markdown)
+    std::string style_sheet;  // CSS regels per class (alleen met Style::css_classes)
+    FragmentBytes fragments[FRAGMENT_COUNT];
+    std::string line_slab;  // "\n" plus SLAB_LEVELS niveaus indent
+    size_t slab_spaces = 0;
+    // Eigenaar van de key/path teksten; de map en de matcher verwijzen ernaar
+    // zodat een lookup met een std::string_view geen tijdelijke string nodig heeft
+    std::vector<std::string> rule_names;
+    // Key regels matchen op de exacte key naam op elke diepte
+    std::unordered_map<std::string_view, ColorSlot> key_slots;
+    // Regels als pad ("user.name", "users[*].email") per afdaling
+    PathMatcher matcher;
+
+    template<typename Render>
+    CompiledStyle(const Style& style, Render render, std::string close, bool is_markup)
+        : close_seq(std::move(close)), markup(is_markup) {
+        size_t slot_count = ELEMENT_TYPE_COUNT + style.key_colors.size() + style.value_colors.size();
+        table.reserve(slot_count);
+        runs.reserve(slot_count);
+        rule_names.reserve(style.key_colors.size() + style.value_colors.size());
+        std::unordered_map<std::string, ColorSlot> first_slot;
+        auto add = [&](const Color* color) {
+            auto slot = static_cast<ColorSlot>(table.size());
+            table.push_back(color ? render(*color, slot) : std::string());
+            SlotRun info;
+            if (!table.back().empty()) {
+                colored = true;
+                info.run = first_slot.emplace(table.back(), slot).first->second;
+                info.attributes = color->bold || color->italic || color->underline;
+                info.underline = color->underline;
+            }
+            runs.push_back(info);
+            return slot;
+        };
+
+        for (size_t i = 0; i < ELEMENT_TYPE_COUNT; i++) {
+            auto type = static_cast<ElementType>(i);
+            Color color = style.elementColor(type);
+            add(type == ElementType::Whitespace ? nullptr : &color);
+        }
+        for (const auto& entry : style.key_colors) {
+            rule_names.push_back(entry.first);
+            ColorSlot slot = add(&entry.second);
+            std::string_view name = rule_names.back();
+            // Een key met precies deze naam matcht altijd, ook als de naam op
+            // een pad lijkt
+            key_slots.emplace(name, slot);
+            if (name.find_first_of(".[*") != std::string_view::npos) {
+                matcher.addRule(name, slot, true);
+            }
+        }
+        for (const auto& entry : style.value_colors) {
+            rule_names.push_back(entry.first);
+            std::string_view name = rule_names.back();
+            ColorSlot slot = add(&entry.second);
+            matcher.addRule(name, slot, false);
+            if (name.find_first_of(".[*") != std::string_view::npos) {
+                matcher.addRootKeyRule(name, slot, false);
+            }
+        }
+        matcher.compile();
+    }
+
+    void addFragment(Fragment id, ElementType type, std::string_view text,
+                     std::string_view trailing, size_t trailing_spaces) {
+        FragmentBytes& f = fragments[static_cast<size_t>(id)];
+        f.slab_spaces = trailing_spaces;
+        f.run = runs[slotOf(type)].run;
+        // Onderstreping niet doortrekken over de whitespace erna
+        bool close_first = f.run != NO_SLOT && runs[f.run].underline && !trailing.empty();
+        std::string body(markup && text == "\"" ? std::string_view("&quot;") : text);
+        if (close_first) body += close_seq;
+        body.append(trailing.data(), trailing.size());
+        f.after = close_first ? NO_SLOT : f.run;
+        std::string open_seq = f.run != NO_SLOT ? table[f.run] : std::string();
+        f.variants[0] = body;
+        f.variants[1] = open_seq + body;
+        f.variants[2] = close_seq + open_seq + body;
+    }
+
+    // HTML spans: inline style per span, of met Style::css_classes een korte
+    // class per span plus één stylesheet. Slots met dezelfde CSS delen een class.
+    template<typename CssColor>
+    static CompiledStyle markupStyle(const Style& style, CssColor css_color) {
+        std::string sheet;
+        std::unordered_map<std::string, std::string> class_of;
+        size_t key_color_count = style.key_colors.size();
+        CompiledStyle compiled(style, [&](const Color& c, ColorSlot slot) {
+            std::string decl = cssDeclarations(c, css_color(c));
+            if (!style.css_classes) {
+                return "<span style=\"" + decl + "\">";
+            }
+            auto found = class_of.find(decl);
+            if (found == class_of.end()) {
+                std::string name = cssClassName(slot, key_color_count);
+                sheet += "    ." + name + " { " + decl + " }\n";
+                found = class_of.emplace(decl, name).first;
+            }
+            return "<span class=\"" + found->second + "\">";
+        }, "</span>", true);
+        compiled.style_sheet = std::move(sheet);
+        compiled.buildFragments(style);
+        return compiled;
+    }
+
+    void buildFragments(const Style& style) {
+        size_t indent = style.indent_size > 0 ? static_cast<size_t>(style.indent_size) : 0;
+        slab_spaces = style.compact ? 0 : indent * SLAB_LEVELS;
+        line_slab = "\n" + std::string(slab_spaces, ' ');
+        std::string_view separator_tail = style.compact ? std::string_view() : std::string_view(line_slab);
+
+        addFragment(Fragment::OpenBrace, ElementType::Brace, "{", {}, 0);
+        addFragment(Fragment::CloseBrace, ElementType::Brace, "}", {}, 0);
+        addFragment(Fragment::EmptyBrace, ElementType::Brace, "{}", {}, 0);
+        addFragment(Fragment::OpenBracket, ElementType::Bracket, "[", {}, 0);
+        addFragment(Fragment::CloseBracket, ElementType::Bracket, "]", {}, 0);
+        addFragment(Fragment::EmptyBracket, ElementType::Bracket, "[]", {}, 0);
+        addFragment(Fragment::Separator, ElementType::Comma, ",", separator_tail, slab_spaces);
+        addFragment(Fragment::Colon, ElementType::Colon, ":", style.compact ? "" : " ", 0);
+        addFragment(Fragment::KeyQuote, ElementType::KeyQuote, "\"", {}, 0);
+        addFragment(Fragment::StringQuote, ElementType::StringQuote, "\"", {}, 0);
+    }
+
+public:
+    CompiledStyle() = default;
+    // Verplaatsen houdt de rule_names buffer (en dus de map keys) intact, kopiëren niet
+    CompiledStyle(CompiledStyle&&) = default;
+    CompiledStyle& operator=(CompiledStyle&&) = default;
+    CompiledStyle(const CompiledStyle&) = delete;
+    CompiledStyle& operator=(const CompiledStyle&) = delete;
+
+    // ANSI escape codes; ColorMode::Auto wordt hier eenmalig opgelost
+    static CompiledStyle ansi(const Style& style) {
+        ColorMode mode = resolveColorMode(style.color_mode);
+        CompiledStyle compiled(style, [mode](const Color& c, ColorSlot) { return c.toAnsi(mode); }, "\033[0m", false);
+        compiled.buildFragments(style);
+        return compiled;
+    }
+
+    // <span> met rgb() kleuren (HtmlPrinter)
+    static CompiledStyle html(const Style& style) {
+        return markupStyle(style, colorToCss);
+    }
+
+    // <span> met hex kleuren (MarkdownPrinter)
+    static CompiledStyle markdown(const Style& style) {
+        return markupStyle(style, colorToHex);
+    }
+
+    const std::string& open(ColorSlot slot) const { return table[slot]; }
+    const std::string& close() const { return close_seq; }
+
+    // CSS regels voor de classes, één per regel; leeg zonder Style::css_classes
+    const std::string& styleSheet() const { return style_sheet; }
+
+    // Slots met identieke open bytes delen één run; NO_SLOT voor een slot zonder kleur
+    ColorSlot runOf(ColorSlot slot) const { return runs[slot].run; }
+    bool hasAttributes(ColorSlot slot) const { return runs[slot].attributes; }
+    bool isUnderlined(ColorSlot slot) const { return runs[slot].underline; }
+
+    // Variant van een fragment (of kleurwissel) vanaf de actieve kleur active.
+    // Een open <span> moet altijd eerst dicht.
+    size_t variantFor(ColorSlot active, ColorSlot run) const {
+        if (active == run) return 0;
+        if (active != NO_SLOT && (run == NO_SLOT || markup || runs[active].attributes)) return 2;
+        return 1;
+    }
+
+    const FragmentBytes& fragment(Fragment id) const { return fragments[static_cast<size_t>(id)]; }
+    const std::string& lineSlab() const { return line_slab; }
+    size_t lineSlabSpaces() const { return slab_spaces; }
+    size_t slotCount() const { return table.size(); }
+    bool hasColor() const { return colored; }
+
+    // Zijn er key/value regels? Zo niet, dan hoeft de printer niets bij te houden
+    bool hasRules() const { return !key_slots.empty() || !matcher.empty(); }
+
+    const PathMatcher& paths() const { return matcher; }
+
+    // Slot voor een key: exacte key match gaat voor path match (bijv. "user.name").
+    // state is de matcher toestand na de stap naar deze key.
+    ColorSlot keySlot(std::string_view key, PathMatcher::State state) const {
+        if (!key_slots.empty()) {
+            auto it = key_slots.find(key);
+            if (it != key_slots.end()) return it->second;
+        }
+        ColorSlot slot = matcher.keySlot(state);
+        return slot != NO_SLOT ? slot : slotOf(ElementType::Key);
+    }
+
+    // Slot voor een individuele value kleur, of NO_SLOT als er geen is
+    ColorSlot valueSlot(PathMatcher::State state) const {
+        return matcher.valueSlot(state);
+    }
+};
+
+} // namespace colored_json
@@ -0,0 +1,158 @@
+#pragma once
+#include "compiled_style.hpp"
+#include "escape.hpp"
+#include "output_buffer.hpp"
+#include <string>
+#include <string_view>
+
+namespace colored_json {
+
+// Emitters zetten de tokens van de traversal (render_engine.hpp) om in bytes.
+// Elke emitter biedt dezelfde operaties, per RenderPolicy geïnstantieerd:
+//   fragment<P>(id)          structureel stuk uit de CompiledStyle
+//   lineBreak<P>()           newline plus indent van het huidige niveau
+//   token<P>(slot, text)     tekst die al geldige JSON is (getal, raw string)
+//   escapedToken<P>(slot, s) gedecodeerde string die JSON-escaped moet worden
+//   finish()                 afsluiten na het laatste token
+// plus increaseIndent() en decreaseIndent().
+
+// Output als runs van één kleur. De emitter houdt de actieve kleur bij, zodat
+// opeenvolgende tokens met dezelfde kleur één escape (ANSI) of één <span>
+// (HTML) delen. Met Markup wordt alle tekst bovendien HTML-escaped.
+template<bool Markup>
+class RunEmitter {
+private:
+    OutputBuffer& output;
+    const CompiledStyle& compiled;
+    int indent_size;
+    int indent_level = 0;
+    ColorSlot active_run = NO_SLOT;  // Kleur (of open <span>) die nu actief is
+
+    size_t indentSpaces() const {
+        return static_cast<size_t>(indent_level * indent_size);
+    }
+
+    // Kopieer een slab tot het gevraagde aantal indent spaties; dieper dan de
+    // slab wordt aangevuld
+    void appendSlab(const std::string& slab, size_t slab_spaces, size_t spaces) {
+        if (spaces <= slab_spaces) {
+            output.append(slab.data(), slab.size() - (slab_spaces - spaces));
+        } else {
+            output.append(slab);
+            output.append(spaces - slab_spaces, ' ');
+        }
+    }
+
+    // Schakel alleen van kleur als de toestand echt verandert. Blijven er
+    // attributen (bold/italic/underline) staan of is er een <span> open, dan
+    // eerst een reset of </span>.
+    template<typename P>
+    void setColor(ColorSlot slot) {
+        if constexpr (P::color) {
+            ColorSlot run = compiled.runOf(slot);
+            size_t variant = compiled.variantFor(active_run, run);
+            if (variant == 0) return;
+            if (variant == 2) output.append(compiled.close());
+            if (run != NO_SLOT) output.append(compiled.open(run));
+            active_run = run;
+        }
+    }
+
+    // Whitespace mag de huidige kleur houden, behalve een onderstreping
+    template<typename P>
+    void plainText() {
+        if constexpr (P::color) {
+            if (active_run != NO_SLOT && compiled.isUnderlined(active_run)) {
+                output.append(compiled.close());
+                active_run = NO_SLOT;
+            }
+        }
+    }
+
+public:
+    RunEmitter(OutputBuffer& out, const CompiledStyle& c, int indent)
+        : output(out), compiled(c), indent_size(indent) {}
+
+    void increaseIndent() { indent_level++; }
+    void decreaseIndent() { indent_level--; }
+
+    // Toestand voor een deel dat elders gerenderd wordt (parallel_render.hpp):
+    // ga verder op indent niveau level met actieve kleur run
+    void resume(int level, ColorSlot run) {
+        indent_level = level;
+        active_run = run;
+    }
+
+    ColorSlot activeRun() const { return active_run; }
+
+    // Neem een elders gerenderd deel over; run is de actieve kleur erna
+    void appendRendered(std::string_view bytes, ColorSlot run) {
+        output.append(bytes);
+        active_run = run;
+    }
+
+    // Vooraf gerenderd fragment; de variant hangt af van de actieve kleur
+    template<typename P>
+    void fragment(Fragment id) {
+        const FragmentBytes& f = compiled.fragment(id);
+        const std::string* bytes = &f.variants[0];
+        if constexpr (P::color) {
+            bytes = &f.variants[compiled.variantFor(active_run, f.run)];
+            active_run = f.after;
+        }
+        if constexpr (P::compact) {
+            output.append(*bytes);
+        } else if (f.slab_spaces > 0) {
+            appendSlab(*bytes, f.slab_spaces, indentSpaces());
+        } else {
+            output.append(*bytes);
+        }
+    }
+
+    template<typename P>
+    void lineBreak() {
+        if constexpr (!P::compact) {
+            plainText<P>();
+            appendSlab(compiled.lineSlab(), compiled.lineSlabSpaces(), indentSpaces());
+        }
+    }
+
+    template<typename P>
+    void token(ColorSlot slot, std::string_view text) {
+        setColor<P>(slot);
+        if constexpr (Markup) {
+            appendHtmlEscaped(output, text);
+        } else {
+            output.append(text);
+        }
+    }
+
+    // De inhoud wordt direct (en met Markup in dezelfde pass HTML-) escaped
+    // in de output geschreven
+    template<typename P>
+    void escapedToken(ColorSlot slot, std::string_view s) {
+        setColor<P>(slot);
+        if constexpr (Markup) {
+            appendJsonHtmlEscaped(output, s);
+        } else {
+            appendJsonEscaped(output, s);
+        }
+    }
+
+    // Eén reset (of </span>) aan het einde van de output
+    void finish() {
+        if (active_run != NO_SLOT) output.append(compiled.close());
+        active_run = NO_SLOT;
+    }
+};
+
+// Terminal output met ANSI escape codes. Zonder kleur (P::color == false,
+// ColorMode::Disabled) is dit de platte backend: alleen tekst en whitespace.
+using AnsiEmitter = RunEmitter<false>;
+
+// HTML output (HtmlPrinter en MarkdownPrinter): <span> elementen met
+// HTML-escaped inhoud. De CompiledStyle bepaalt of de kleuren als inline
+// rgb()/hex style of als CSS class worden geschreven.
+using HtmlEmitter = RunEmitter<true>;
+
+} // namespace colored_json
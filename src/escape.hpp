@@ -0,0 +1,217 @@
+#pragma once
+#include "output_buffer.hpp"
+#include <cstdint>
+#include <string_view>
+
+// SIMD variant op basis van de doelarchitectuur (-march=native, /arch:AVX2)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COLORED_JSON_ESCAPE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLORED_JSON_ESCAPE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define COLORED_JSON_ESCAPE_NEON
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace colored_json {
+
+namespace detail {
+
+inline unsigned trailingZeros(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, static_cast<unsigned long>(mask));  // x86: masks zijn max 32 bits
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+inline bool needsJsonEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+// Bytes die in HTML een entity worden (< > & " ')
+inline bool needsHtmlEscape(unsigned char c) {
+    return c == '<' || c == '>' || c == '&' || c == '"' || c == '\'';
+}
+
+// Eerste byte in [p, end) die ge-escaped moet worden, of end. Altijd de JSON
+// bytes (", \ of < 0x20); met Html ook < > & en '. Schone stukken worden per
+// 32 (AVX2) of 16 (SSE2/NEON) bytes overgeslagen.
+template<bool Html>
+inline const char* findEscape(const char* p, const char* end) {
+#if defined(COLORED_JSON_ESCAPE_AVX2)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control_max = _mm256_set1_epi8(0x1F);
+    const __m256i lt = _mm256_set1_epi8('<');
+    const __m256i gt = _mm256_set1_epi8('>');
+    const __m256i amp = _mm256_set1_epi8('&');
+    const __m256i apos = _mm256_set1_epi8('\'');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(v, control_max), v));
+        if constexpr (Html) {
+            hits = _mm256_or_si256(hits, _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, lt), _mm256_cmpeq_epi8(v, gt)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, amp), _mm256_cmpeq_epi8(v, apos))));
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask) return p + trailingZeros(mask);
+        p += 32;
+    }
+#endif
+#if defined(COLORED_JSON_ESCAPE_AVX2) || defined(COLORED_JSON_ESCAPE_SSE2)
+    const __m128i quote16 = _mm_set1_epi8('"');
+    const __m128i backslash16 = _mm_set1_epi8('\\');
+    const __m128i control_max16 = _mm_set1_epi8(0x1F);
+    const __m128i lt16 = _mm_set1_epi8('<');
+    const __m128i gt16 = _mm_set1_epi8('>');
+    const __m128i amp16 = _mm_set1_epi8('&');
+    const __m128i apos16 = _mm_set1_epi8('\'');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote16), _mm_cmpeq_epi8(v, backslash16)),
+            _mm_cmpeq_epi8(_mm_min_epu8(v, control_max16), v));
+        if constexpr (Html) {
+            hits = _mm_or_si128(hits, _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, lt16), _mm_cmpeq_epi8(v, gt16)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, amp16), _mm_cmpeq_epi8(v, apos16))));
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask) return p + trailingZeros(mask);
+        p += 16;
+    }
+#elif defined(COLORED_JSON_ESCAPE_NEON)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t control_end = vdupq_n_u8(0x20);
+    const uint8x16_t lt = vdupq_n_u8('<');
+    const uint8x16_t gt = vdupq_n_u8('>');
+    const uint8x16_t amp = vdupq_n_u8('&');
+    const uint8x16_t apos = vdupq_n_u8('\'');
+    while (end - p >= 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+                                   vcltq_u8(v, control_end));
+        if constexpr (Html) {
+            hits = vorrq_u8(hits, vorrq_u8(vorrq_u8(vceqq_u8(v, lt), vceqq_u8(v, gt)),
+                                           vorrq_u8(vceqq_u8(v, amp), vceqq_u8(v, apos))));
+        }
+        // 4 bits per byte: eerste hit = trailing zeros / 4
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(
+            vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask) return p + (trailingZeros(mask) >> 2);
+        p += 16;
+    }
+#endif
+    while (p < end) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (needsJsonEscape(c) || (Html && needsHtmlEscape(c))) break;
+        p++;
+    }
+    return p;
+}
+
+// JSON escape van één byte die needsJsonEscape is; " wordt quote
+inline void appendJsonEscape(OutputBuffer& out, unsigned char c, std::string_view quote) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    switch (c) {
+        case '"':  out.push_back('\\'); out.append(quote); break;
+        case '\\': out.append("\\\\", 2); break;
+        case '\b': out.append("\\b", 2); break;
+        case '\f': out.append("\\f", 2); break;
+        case '\n': out.append("\\n", 2); break;
+        case '\r': out.append("\\r", 2); break;
+        case '\t': out.append("\\t", 2); break;
+        default: {
+            char esc[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+            out.append(esc, 6);
+        }
+    }
+}
+
+// HTML entity voor een byte die needsHtmlEscape is
+inline std::string_view htmlEntity(unsigned char c) {
+    switch (c) {
+        case '<':  return "&lt;";
+        case '>':  return "&gt;";
+        case '&':  return "&amp;";
+        case '"':  return "&quot;";
+        default:   return "&#39;";
+    }
+}
+
+} // namespace detail
+
+// Schrijf s als JSON string inhoud (zonder quotes) naar out. Schone runs
+// worden in één keer gekopieerd; alleen de gevonden bytes worden vervangen.
+inline void appendJsonEscaped(OutputBuffer& out, std::string_view s) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (true) {
+        const char* hit = detail::findEscape<false>(p, end);
+        out.append(p, static_cast<size_t>(hit - p));
+        if (hit == end) break;
+        p = hit + 1;
+        detail::appendJsonEscape(out, static_cast<unsigned char>(*hit), "\"");
+    }
+}
+
+// Schrijf s met HTML entities voor < > & " ' naar out. De scan vindt ook
+// \ en control bytes; die worden ongewijzigd gekopieerd.
+inline void appendHtmlEscaped(OutputBuffer& out, std::string_view s) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (true) {
+        const char* hit = detail::findEscape<true>(p, end);
+        if (hit == end) {
+            out.append(p, static_cast<size_t>(end - p));
+            break;
+        }
+        unsigned char c = static_cast<unsigned char>(*hit);
+        if (detail::needsHtmlEscape(c)) {
+            out.append(p, static_cast<size_t>(hit - p));
+            out.append(detail::htmlEntity(c));
+            p = hit + 1;
+        } else {
+            out.append(p, static_cast<size_t>(hit + 1 - p));
+            p = hit + 1;
+        }
+    }
+}
+
+// JSON escape en HTML escape in één pass direct naar out: gelijk aan
+// appendHtmlEscaped(appendJsonEscaped(s)), zonder tussenbuffer
+inline void appendJsonHtmlEscaped(OutputBuffer& out, std::string_view s) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (true) {
+        const char* hit = detail::findEscape<true>(p, end);
+        out.append(p, static_cast<size_t>(hit - p));
+        if (hit == end) break;
+        p = hit + 1;
+        unsigned char c = static_cast<unsigned char>(*hit);
+        if (detail::needsJsonEscape(c)) {
+            detail::appendJsonEscape(out, c, "&quot;");
+        } else {
+            out.append(detail::htmlEntity(c));
+        }
+    }
+}
+
+} // namespace colored_json
@@ -1,34 +1,175 @@
 #pragma once
 #include <simdjson.h>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace colored_json {
 
+// Kleinste gangbare pagina grootte; lezen binnen dezelfde pagina kan niet falen
+constexpr size_t MIN_PAGE_SIZE = 4096;
+
+// simdjson leest tot SIMDJSON_PADDING bytes voorbij de input (de inhoud doet
+// er niet toe). Dat kan zonder kopie als die bytes op dezelfde pagina liggen
+// als het laatste byte van de input.
+inline bool paddingReadable(const char* data, size_t size) {
+    if (size == 0) return false;
+    uintptr_t last = reinterpret_cast<uintptr_t>(data + size - 1);
+    return last % MIN_PAGE_SIZE + 1 + simdjson::SIMDJSON_PADDING <= MIN_PAGE_SIZE;
+}
+
+// JSON input met padding: leent de buffer als dat veilig kan (zie
+// paddingReadable) en kopieert alleen anders. De buffer moet blijven bestaan
+// zolang de view gebruikt wordt.
+class PaddedInput {
+private:
+    simdjson::padded_string copy;
+    simdjson::padded_string_view view_;
+
+public:
+    explicit PaddedInput(std::string_view json) {
+        if (paddingReadable(json.data(), json.size())) {
+            view_ = simdjson::padded_string_view(json.data(), json.size(), json.size() + simdjson::SIMDJSON_PADDING);
+        } else {
+            copy = simdjson::padded_string(json);
+            view_ = copy;
+        }
+    }
+
+    PaddedInput(const PaddedInput&) = delete;
+    PaddedInput& operator=(const PaddedInput&) = delete;
+
+    simdjson::padded_string_view view() const { return view_; }
+    const char* data() const { return view_.data(); }
+    size_t size() const { return view_.size(); }
+};
+
+// Een geparst ondemand document samen met zijn input. Het document wijst in
+// de (gepadde) input, dus die leeft hier precies zo lang als het document.
+// De parser moet het document overleven en mag intussen geen ander document
+// parsen. Niet te kopiëren of verplaatsen; een functie kan er wel een
+// teruggeven (return ParsedDocument(...)).
+class ParsedDocument {
+private:
+    PaddedInput input_;
+    simdjson::ondemand::document doc;
+
+public:
+    // Leent json, of bezit een kopie als de padding niet leesbaar is (zie
+    // PaddedInput)
+    ParsedDocument(simdjson::ondemand::parser& parser, std::string_view json)
+        : input_(json), doc(parser.iterate(input_.view())) {}
+
+    ParsedDocument(const ParsedDocument&) = delete;
+    ParsedDocument& operator=(const ParsedDocument&) = delete;
+
+    simdjson::ondemand::document& document() { return doc; }
+
+    // Root value; een fout wordt een runtime_error
+    simdjson::ondemand::value root() {
+        simdjson::ondemand::value val;
+        if (doc.get_value().get(val)) {
+            throw std::runtime_error("Failed to get document value");
+        }
+        return val;
+    }
+
+    // Input zoals de parser hem ziet (begin voor offsets van raw_json())
+    const char* data() const { return input_.data(); }
+    size_t size() const { return input_.size(); }
+};
+
+// Ondemand parsers per thread. Een render leent een parser (Lease) en geeft
+// hem na afloop terug; wie tijdens die render nog een parser nodig heeft
+// (bijv. een deel van een parallelle render dat via helpUntil op dezelfde
+// thread draait) krijgt een andere. Parsers gaan nooit naar een andere
+// thread, dus gelijktijdige renders zonder GIL delen of hergroeien geen
+// parser state. Een parser die moet groeien krijgt meteen de grootte van
+// het grootste document dat op deze thread gezien is.
+class ParserPool {
+private:
+    std::vector<std::unique_ptr<simdjson::ondemand::parser>> free_;
+    size_t largest = 0;
+
+    static ParserPool& local() {
+        thread_local ParserPool pool;
+        return pool;
+    }
+
+public:
+    class Lease {
+    private:
+        std::unique_ptr<simdjson::ondemand::parser> parser;
+
+    public:
+        explicit Lease(std::unique_ptr<simdjson::ondemand::parser> p) : parser(std::move(p)) {}
+        Lease(Lease&&) = default;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() {
+            if (parser) local().free_.push_back(std::move(parser));
+        }
+
+        simdjson::ondemand::parser& operator*() { return *parser; }
+        simdjson::ondemand::parser* operator->() { return parser.get(); }
+    };
+
+    // Parser voor een document van size bytes (0 = onbekend); op dezelfde
+    // thread teruggeven, wat de Lease destructor vanzelf doet
+    static Lease acquire(size_t size = 0) {
+        ParserPool& pool = local();
+        std::unique_ptr<simdjson::ondemand::parser> parser;
+        if (pool.free_.empty()) {
+            parser = std::make_unique<simdjson::ondemand::parser>();
+        } else {
+            parser = std::move(pool.free_.back());
+            pool.free_.pop_back();
+        }
+        if (size > pool.largest) pool.largest = size;
+        if (size > 0 && parser->capacity() < size) {
+            // Een fout (bijv. te groot document) meldt iterate() zelf
+            simdjson::error_code error = parser->allocate(pool.largest);
+            (void)error;
+        }
+        return Lease(std::move(parser));
+    }
+
+    // Gooi vrije parsers van deze thread weg die groter zijn dan max_capacity
+    static void trim(size_t max_capacity) {
+        ParserPool& pool = local();
+        for (auto& parser : pool.free_) {
+            if (parser->capacity() > max_capacity) parser = std::make_unique<simdjson::ondemand::parser>();
+        }
+        if (pool.largest > max_capacity) pool.largest = max_capacity;
+    }
+};
+
 class JsonParser {
 private:
     simdjson::ondemand::parser parser;
     
 public:
-    // Parse JSON string en retourneer document
-    simdjson::ondemand::document parse(const std::string& json_str) {
-        simdjson::padded_string json(json_str);
-        simdjson::ondemand::document doc = parser.iterate(json);
-        return doc;
+    // Parse een JSON string. Een eventuele kopie voor de padding leeft in het
+    // ParsedDocument; json zelf moet blijven bestaan zolang het document
+    // gebruikt wordt.
+    ParsedDocument parse(std::string_view json_str) {
+        return ParsedDocument(parser, json_str);
     }
     
-    // Parse JSON string en retourneer value (voor root object)
-    simdjson::ondemand::value parseValue(const std::string& json_str) {
-        auto doc = parse(json_str);
-        return doc.get_value();
+    // Meerdere documenten achter elkaar (JSONL); json moet blijven bestaan
+    // zolang de stream gebruikt wordt
+    simdjson::ondemand::document_stream parseMany(simdjson::padded_string& json) {
+        return parser.iterate_many(json);
     }
     
     // Check of JSON string geldig is (zonder exception)
-    bool isValid(const std::string& json_str) {
+    bool isValid(std::string_view json_str) {
         try {
-            simdjson::padded_string json(json_str);
-            simdjson::ondemand::document doc = parser.iterate(json);
-            doc.get_value(); // Probeer value te krijgen
+            ParsedDocument doc(parser, json_str);
+            doc.root(); // Probeer value te krijgen
             return true;
         } catch (...) {
             return false;
@@ -36,6 +177,23 @@ public:
     }
 };
 
+// raw_json_token() loopt door tot de volgende structurele byte; knip de
+// whitespace daarachter af
+inline std::string_view trimRawToken(std::string_view token) {
+    size_t end = token.size();
+    while (end > 0 && (token[end - 1] == ' ' || token[end - 1] == '\n' ||
+                       token[end - 1] == '\r' || token[end - 1] == '\t')) {
+        end--;
+    }
+    return token.substr(0, end);
+}
+
+// Inhoud tussen de quotes van een string token, nog in ge-escapete vorm
+inline std::string_view rawStringContent(std::string_view token) {
+    token = trimRawToken(token);
+    return token.substr(1, token.size() - 2);
+}
+
 // Helper functie om simdjson error te converteren naar runtime_error
 inline std::runtime_error jsonError(const std::string& json_str, const std::string& error_msg) {
     return std::runtime_error("JSON parsing error: " + error_msg + 
@@ -1,628 +1,240 @@
 #pragma once
 #include "style.hpp"
-#include "json_parser.hpp"
+#include "compiled_style.hpp"
+#include "output_buffer.hpp"
+#include "emitters.hpp"
+#include "py_render_engine.hpp"
+#include "parallel_render.hpp"
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
-#include <simdjson.h>
-#include <sstream>
-#include <iomanip>
+#include <memory>
+#include <string_view>
 
 namespace py = pybind11;
-using namespace simdjson;
 
 namespace colored_json {
 
+// Markdown document: de gedeelde traversal met de HtmlEmitter (hex kleuren),
+// in een code block of een HTML block. Output buffer en CompiledStyle
+// blijven tussen renders staan, net als bij Printer.
 class MarkdownPrinter {
 private:
-    const Style& style;
-    std::stringstream output;
-    int indent_level = 0;
-    std::string current_path;
+    const Style* source;                 // Style van de aanroeper; nullptr bij een vaste snapshot
+    std::shared_ptr<const Style> style;  // Snapshot waarmee compiled gebouwd is
+    CompiledStyle compiled;  // <span> open tags per slot, alleen na een Style wijziging opnieuw gebouwd
+    OutputBuffer output;
+    size_t max_capacity;
     
-    void increaseIndent() { indent_level++; }
-    void decreaseIndent() { indent_level--; }
+    // Geschatte output grootte t.o.v. de JSON input (<span> tags per token)
+    static constexpr size_t OUTPUT_EXPANSION = 4;
     
-    void addIndent() {
-        if (!style.compact) {
-            output << std::string(indent_level * style.indent_size, ' ');
+    void reset() {
+        trim();
+        if (source) {
+            std::shared_ptr<const Style> current = source->snapshot();
+            if (current != style) {
+                compiled = CompiledStyle::markdown(*current);
+                style = std::move(current);
+            }
         }
+        output.clear();
     }
     
-    void addNewline() {
-        if (!style.compact) {
-            output << "\n";
+    // Markdown header met title
+    void writeTitle(std::string_view title) {
+        if (!title.empty()) {
+            output.append("# ");
+            output.append(title);
+            output.append("\n\n");
         }
     }
     
-    std::string colorToHex(const Color& color) const {
-        std::stringstream hex;
-        hex << "#" << std::hex << std::setfill('0') << std::setw(2)
-            << static_cast<int>(color.r) << std::setw(2)
-            << static_cast<int>(color.g) << std::setw(2)
-            << static_cast<int>(color.b);
-        return hex.str();
+    // Eén <style> blok voor de span classes (alleen met Style::css_classes)
+    void writeStyleSheet() {
+        if (!compiled.styleSheet().empty()) {
+            output.append("<style>\n");
+            output.append(compiled.styleSheet());
+            output.append("</style>\n\n");
+        }
     }
     
-    std::string getStyleString(const Color& color) const {
-        std::stringstream style_str;
-        style_str << "color: " << colorToHex(color);
-        if (color.bold) style_str << "; font-weight: bold";
-        if (color.italic) style_str << "; font-style: italic";
-        if (color.underline) style_str << "; text-decoration: underline";
-        return style_str.str();
+    // HTML code block met styling
+    void writeHtmlBlockStart(std::string_view background_color, std::string_view font_family) {
+        output.append("<div style=\"background-color: ");
+        output.append(background_color);
+        output.append("; color: #ffffff; font-family: ");
+        output.append(font_family);
+        output.append("; padding: 20px; border-radius: 5px; overflow-x: auto;\">\n");
+        output.append("<pre style=\"margin: 0; white-space: pre-wrap; word-wrap: break-word;\">");
     }
     
-    void addSpan(const Color& color, const std::string& content) {
-        output << "<span style=\"" << getStyleString(color) << "\">";
-        // Escape HTML special characters
-        for (char c : content) {
-            if (c == '<') output << "&lt;";
-            else if (c == '>') output << "&gt;";
-            else if (c == '&') output << "&amp;";
-            else if (c == '"') output << "&quot;";
-            else if (c == '\'') output << "&#39;";
-            else output << c;
-        }
-        output << "</span>";
+    void renderObject(py::handle obj) {
+        HtmlEmitter emitter(output, compiled, style->indent_size);
+        renderPyObject(emitter, *style, compiled, obj);
     }
     
-    void printString(const std::string& s) {
-        std::stringstream escaped;
-        
-        for (char c : s) {
-            if (c == '"') escaped << "\\\"";
-            else if (c == '\\') escaped << "\\\\";
-            else if (c == '\b') escaped << "\\b";
-            else if (c == '\f') escaped << "\\f";
-            else if (c == '\n') escaped << "\\n";
-            else if (c == '\r') escaped << "\\r";
-            else if (c == '\t') escaped << "\\t";
-            else if (static_cast<unsigned char>(c) < 0x20) {
-                escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                        << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-            }
-            else escaped << c;
-        }
-        
-        addSpan(style.string_quote_color, "\"");
-        addSpan(style.string_color, escaped.str());
-        addSpan(style.string_quote_color, "\"");
+    void renderJson(std::string_view json_str) {
+        HtmlEmitter emitter(output, compiled, style->indent_size);
+        renderJsonDocumentParallel(emitter, *style, compiled, json_str);
     }
     
-    void printKey(const std::string& s, const std::string& path = "") {
-        std::stringstream escaped;
-        
-        for (char c : s) {
-            if (c == '"') escaped << "\\\"";
-            else if (c == '\\') escaped << "\\\\";
-            else if (c == '\b') escaped << "\\b";
-            else if (c == '\f') escaped << "\\f";
-            else if (c == '\n') escaped << "\\n";
-            else if (c == '\r') escaped << "\\r";
-            else if (c == '\t') escaped << "\\t";
-            else if (static_cast<unsigned char>(c) < 0x20) {
-                escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                        << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-            }
-            else escaped << c;
-        }
-        
-        Color key_col = style.key_color;
-        Color quote_col = style.key_quote_color;
-        if (!style.key_colors.empty()) {
-            auto it = style.key_colors.find(s);
-            if (it != style.key_colors.end()) {
-                key_col = it->second;
-            } else if (!path.empty()) {
-                auto path_it = style.key_colors.find(path);
-                if (path_it != style.key_colors.end()) {
-                    key_col = path_it->second;
-                }
-            }
-        }
-        
-        addSpan(quote_col, "\"");
-        addSpan(key_col, escaped.str());
-        addSpan(quote_col, "\"");
+    void renderTapeBody(const TokenTape& tape) {
+        HtmlEmitter emitter(output, compiled, style->indent_size);
+        colored_json::renderTape(emitter, *style, compiled, tape);
     }
-    
-    void printDict(py::dict obj, const std::string& parent_path = "") {
-        if (obj.empty()) {
-            addSpan(style.brace_color, "{}");
-            return;
-        }
-        
-        addSpan(style.brace_color, "{");
-        increaseIndent();
-        
-        bool first = true;
-        for (auto item : obj) {
-            if (!first) {
-                addSpan(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            std::string key_str = py::str(item.first);
-            std::string current_key_path = parent_path.empty() ? key_str : parent_path + "." + key_str;
-            
-            printKey(key_str, current_key_path);
-            
-            addSpan(style.colon_color, ":");
-            if (!style.compact) output << " ";
-            
-            printValue(item.second, current_key_path);
-            first = false;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addSpan(style.brace_color, "}");
+
+public:
+    // max_capacity: zie Printer
+    explicit MarkdownPrinter(const Style& s, size_t max_capacity_ = 0)
+        : MarkdownPrinter(s.snapshot(), max_capacity_) {
+        source = &s;
     }
     
-    void printList(py::list obj, const std::string& parent_path = "") {
-        if (obj.empty()) {
-            addSpan(style.bracket_color, "[]");
-            return;
-        }
-        
-        addSpan(style.bracket_color, "[");
-        increaseIndent();
-        
-        bool first = true;
-        int index = 0;
-        for (auto item : obj) {
-            if (!first) {
-                addSpan(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            std::string item_path = parent_path.empty() ? "" : parent_path + "[" + std::to_string(index) + "]";
-            printValue(item, item_path);
-            first = false;
-            index++;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addSpan(style.bracket_color, "]");
-    }
+    // Met een vaste snapshot, bijv. voor een render op een andere thread
+    explicit MarkdownPrinter(std::shared_ptr<const Style> s, size_t max_capacity_ = 0)
+        : source(nullptr), style(std::move(s)), compiled(CompiledStyle::markdown(*style)),
+          max_capacity(max_capacity_) {}
     
-    void printValue(py::handle obj, const std::string& path = "") {
-        Color value_color;
-        bool has_custom_color = false;
-        
-        if (!style.value_colors.empty() && !path.empty()) {
-            auto it = style.value_colors.find(path);
-            if (it != style.value_colors.end()) {
-                value_color = it->second;
-                has_custom_color = true;
-            }
-        }
-        
-        if (py::isinstance<py::str>(obj)) {
-            if (has_custom_color) {
-                std::string str_val = py::str(obj);
-                std::stringstream escaped;
-                for (char c : str_val) {
-                    if (c == '"') escaped << "\\\"";
-                    else if (c == '\\') escaped << "\\\\";
-                    else if (c == '\b') escaped << "\\b";
-                    else if (c == '\f') escaped << "\\f";
-                    else if (c == '\n') escaped << "\\n";
-                    else if (c == '\r') escaped << "\\r";
-                    else if (c == '\t') escaped << "\\t";
-                    else if (static_cast<unsigned char>(c) < 0x20) {
-                        escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                                << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-                    }
-                    else escaped << c;
-                }
-                addSpan(style.string_quote_color, "\"");
-                addSpan(value_color, escaped.str());
-                addSpan(style.string_quote_color, "\"");
-            } else {
-                printString(py::str(obj));
-            }
-        } else if (py::isinstance<py::dict>(obj)) {
-            printDict(py::reinterpret_borrow<py::dict>(obj), path);
-        } else if (py::isinstance<py::list>(obj)) {
-            printList(py::reinterpret_borrow<py::list>(obj), path);
-        } else if (py::isinstance<py::int_>(obj) || py::isinstance<py::float_>(obj)) {
-            if (has_custom_color) {
-                addSpan(value_color, py::str(obj));
-            } else {
-                addSpan(style.number_color, py::str(obj));
-            }
-        } else if (py::isinstance<py::bool_>(obj)) {
-            if (has_custom_color) {
-                addSpan(value_color, py::str(obj));
-            } else {
-                addSpan(style.bool_color, py::str(obj));
-            }
-        } else if (obj.is_none()) {
-            if (has_custom_color) {
-                addSpan(value_color, "null");
-            } else {
-                addSpan(style.null_color, "null");
-            }
-        } else {
-            printString(py::str(obj));
-        }
-    }
+    // Interne output buffer; koppel hier een OutputSink aan om te streamen
+    OutputBuffer& buffer() { return output; }
     
-public:
-    explicit MarkdownPrinter(const Style& s) : style(s) {}
+    size_t maxCapacity() const { return max_capacity; }
+    void setMaxCapacity(size_t n) { max_capacity = n; }
     
-    std::string print(py::handle obj, const std::string& title = "Colored JSON",
-                     const std::string& language = "json") {
-        output.str("");
-        output.clear();
-        indent_level = 0;
-        current_path = "";
-        
-        // Markdown header met title
-        if (!title.empty()) {
-            output << "# " << title << "\n\n";
-        }
+    // Geef buffers groter dan max_capacity terug; de vorige view vervalt
+    void trim() {
+        if (max_capacity == 0) return;
+        if (output.capacity() > max_capacity) output.shrinkTo(max_capacity);
+        ParserPool::trim(max_capacity);
+    }
+    
+    // Render naar de interne buffer; de view is geldig tot de volgende render
+    std::string_view render(py::handle obj, std::string_view title = "Colored JSON",
+                            std::string_view language = "json") {
+        reset();
+        writeTitle(title);
+        writeStyleSheet();
         
         // Code block start
-        output << "```" << language << "\n";
+        output.append("```");
+        output.append(language);
+        output.push_back('\n');
         
-        if (py::isinstance<py::dict>(obj)) {
-            printDict(py::reinterpret_borrow<py::dict>(obj), "");
-        } else if (py::isinstance<py::list>(obj)) {
-            printList(py::reinterpret_borrow<py::list>(obj), "");
-        } else {
-            printValue(obj, "");
-        }
+        renderObject(obj);
         
         // Code block end
-        output << "\n```\n";
-        
-        return output.str();
+        output.append("\n```\n");
+        output.flush();
+        return output.view();
+    }
+    
+    std::string print(py::handle obj, std::string_view title = "Colored JSON",
+                     std::string_view language = "json") {
+        return std::string(render(obj, title, language));
     }
     
     // Alternatieve methode: HTML in Markdown (voor betere kleur ondersteuning)
-    std::string printHtml(py::handle obj, const std::string& title = "Colored JSON",
-                         const std::string& background_color = "#1e1e1e",
-                         const std::string& font_family = "Consolas, 'Courier New', monospace") {
-        output.str("");
-        output.clear();
-        indent_level = 0;
-        current_path = "";
-        
-        // Markdown header
-        if (!title.empty()) {
-            output << "# " << title << "\n\n";
-        }
-        
-        // HTML code block met styling
-        output << "<div style=\"background-color: " << background_color 
-               << "; color: #ffffff; font-family: " << font_family 
-               << "; padding: 20px; border-radius: 5px; overflow-x: auto;\">\n";
-        output << "<pre style=\"margin: 0; white-space: pre-wrap; word-wrap: break-word;\">";
-        
-        if (py::isinstance<py::dict>(obj)) {
-            printDict(py::reinterpret_borrow<py::dict>(obj), "");
-        } else if (py::isinstance<py::list>(obj)) {
-            printList(py::reinterpret_borrow<py::list>(obj), "");
-        } else {
-            printValue(obj, "");
-        }
+    std::string_view renderHtml(py::handle obj, std::string_view title = "Colored JSON",
+                                std::string_view background_color = "#1e1e1e",
+                                std::string_view font_family = "Consolas, 'Courier New', monospace") {
+        reset();
+        writeTitle(title);
+        writeStyleSheet();
+        writeHtmlBlockStart(background_color, font_family);
         
-        output << "</pre>\n";
-        output << "</div>\n";
+        renderObject(obj);
         
-        return output.str();
+        output.append("</pre>\n");
+        output.append("</div>\n");
+        output.flush();
+        return output.view();
     }
     
-    // JSON string versies (werken met simdjson::ondemand::value)
-    void printDictJson(ondemand::object obj, const std::string& parent_path = "") {
-        addSpan(style.brace_color, "{");
-        increaseIndent();
-        
-        bool first = true;
-        bool empty = true;
-        for (auto field : obj) {
-            empty = false;
-            if (!first) {
-                addSpan(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            std::string_view key_view = field.unescaped_key();
-            std::string key_str(key_view);
-            std::string current_key_path = parent_path.empty() ? key_str : parent_path + "." + key_str;
-            
-            printKey(key_str, current_key_path);
-            
-            addSpan(style.colon_color, ":");
-            if (!style.compact) output << " ";
-            
-            ondemand::value val;
-            auto val_error = field.value().get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get field value");
-            }
-            printValueJson(val, current_key_path);
-            first = false;
-        }
-        
-        if (empty) {
-            decreaseIndent();
-            addSpan(style.brace_color, "}");
-            return;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addSpan(style.brace_color, "}");
+    std::string printHtml(py::handle obj, std::string_view title = "Colored JSON",
+                         std::string_view background_color = "#1e1e1e",
+                         std::string_view font_family = "Consolas, 'Courier New', monospace") {
+        return std::string(renderHtml(obj, title, background_color, font_family));
     }
     
-    void printListJson(ondemand::array arr, const std::string& parent_path = "") {
-        addSpan(style.bracket_color, "[");
-        increaseIndent();
+    std::string_view renderFromJson(std::string_view json_str, std::string_view title = "Colored JSON",
+                                    std::string_view language = "json") {
+        reset();
+        output.reserve(json_str.size() * OUTPUT_EXPANSION);
+        writeTitle(title);
+        writeStyleSheet();
         
-        bool first = true;
-        bool empty = true;
-        int index = 0;
-        for (auto element : arr) {
-            empty = false;
-            if (!first) {
-                addSpan(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            std::string item_path = parent_path.empty() ? "" : parent_path + "[" + std::to_string(index) + "]";
-            ondemand::value val;
-            auto val_error = element.get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get array element");
-            }
-            printValueJson(val, item_path);
-            first = false;
-            index++;
-        }
+        output.append("```");
+        output.append(language);
+        output.push_back('\n');
         
-        if (empty) {
-            decreaseIndent();
-            addSpan(style.bracket_color, "]");
-            return;
-        }
+        renderJson(json_str);
         
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addSpan(style.bracket_color, "]");
+        output.append("\n```\n");
+        output.flush();
+        return output.view();
     }
     
-    void printValueJson(ondemand::value val, const std::string& path = "") {
-        Color value_color;
-        bool has_custom_color = false;
-        
-        if (!style.value_colors.empty() && !path.empty()) {
-            auto it = style.value_colors.find(path);
-            if (it != style.value_colors.end()) {
-                value_color = it->second;
-                has_custom_color = true;
-            }
-        }
-        
-        ondemand::json_type type;
-        auto type_error = val.type().get(type);
-        if (type_error) {
-            throw std::runtime_error("Failed to get JSON type");
-        }
-        
-        switch (type) {
-            case ondemand::json_type::string: {
-                std::string_view str_view;
-                auto str_error = val.get_string().get(str_view);
-                if (str_error) {
-                    throw std::runtime_error("Failed to get string value");
-                }
-                std::string str_val(str_view);
-                if (has_custom_color) {
-                    std::stringstream escaped;
-                    for (char c : str_val) {
-                        if (c == '"') escaped << "\\\"";
-                        else if (c == '\\') escaped << "\\\\";
-                        else if (c == '\b') escaped << "\\b";
-                        else if (c == '\f') escaped << "\\f";
-                        else if (c == '\n') escaped << "\\n";
-                        else if (c == '\r') escaped << "\\r";
-                        else if (c == '\t') escaped << "\\t";
-                        else if (static_cast<unsigned char>(c) < 0x20) {
-                            escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                                    << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-                        }
-                        else escaped << c;
-                    }
-                    addSpan(style.string_quote_color, "\"");
-                    addSpan(value_color, escaped.str());
-                    addSpan(style.string_quote_color, "\"");
-                } else {
-                    printString(str_val);
-                }
-                break;
-            }
-            case ondemand::json_type::object: {
-                ondemand::object obj;
-                auto obj_error = val.get_object().get(obj);
-                if (obj_error) {
-                    throw std::runtime_error("Failed to get object");
-                }
-                printDictJson(obj, path);
-                break;
-            }
-            case ondemand::json_type::array: {
-                ondemand::array arr;
-                auto arr_error = val.get_array().get(arr);
-                if (arr_error) {
-                    throw std::runtime_error("Failed to get array");
-                }
-                printListJson(arr, path);
-                break;
-            }
-            case ondemand::json_type::number: {
-                std::string_view num_view = val.raw_json_token();
-                std::string num_str(num_view);
-                if (has_custom_color) {
-                    addSpan(value_color, num_str);
-                } else {
-                    addSpan(style.number_color, num_str);
-                }
-                break;
-            }
-            case ondemand::json_type::boolean: {
-                bool b;
-                auto bool_error = val.get_bool().get(b);
-                if (bool_error) {
-                    throw std::runtime_error("Failed to get boolean");
-                }
-                std::string bool_str = b ? "true" : "false";
-                if (has_custom_color) {
-                    addSpan(value_color, bool_str);
-                } else {
-                    addSpan(style.bool_color, bool_str);
-                }
-                break;
-            }
-            case ondemand::json_type::null: {
-                if (has_custom_color) {
-                    addSpan(value_color, "null");
-                } else {
-                    addSpan(style.null_color, "null");
-                }
-                break;
-            }
-        }
+    std::string printFromJson(std::string_view json_str, std::string_view title = "Colored JSON",
+                             std::string_view language = "json") {
+        return std::string(renderFromJson(json_str, title, language));
     }
     
-    std::string printFromJson(const std::string& json_str, const std::string& title = "Colored JSON",
-                             const std::string& language = "json") {
-        output.str("");
-        output.clear();
-        indent_level = 0;
-        current_path = "";
-        
-        if (!title.empty()) {
-            output << "# " << title << "\n\n";
-        }
-        
-        output << "```" << language << "\n";
-        
-        try {
-            JsonParser parser;
-            auto doc = parser.parse(json_str);
-            ondemand::value val;
-            auto val_error = doc.get_value().get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get document value");
-            }
-            
-            ondemand::json_type type;
-            auto error = val.type().get(type);
-            if (error) {
-                throw std::runtime_error("Failed to get JSON type");
-            }
-            
-            if (type == ondemand::json_type::object) {
-                ondemand::object obj;
-                auto obj_error = val.get_object().get(obj);
-                if (obj_error) {
-                    throw std::runtime_error("Failed to get object");
-                }
-                printDictJson(obj, "");
-            } else if (type == ondemand::json_type::array) {
-                ondemand::array arr;
-                auto arr_error = val.get_array().get(arr);
-                if (arr_error) {
-                    throw std::runtime_error("Failed to get array");
-                }
-                printListJson(arr, "");
-            } else {
-                printValueJson(val, "");
-            }
-        } catch (const simdjson_error& e) {
-            throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
-        } catch (const std::exception& e) {
-            throw std::runtime_error("JSON processing error: " + std::string(e.what()));
-        }
+    std::string_view renderHtmlFromJson(std::string_view json_str, std::string_view title = "Colored JSON",
+                                        std::string_view background_color = "#1e1e1e",
+                                        std::string_view font_family = "Consolas, 'Courier New', monospace") {
+        reset();
+        output.reserve(json_str.size() * OUTPUT_EXPANSION);
+        writeTitle(title);
+        writeStyleSheet();
+        writeHtmlBlockStart(background_color, font_family);
         
-        output << "\n```\n";
+        renderJson(json_str);
         
-        return output.str();
+        output.append("</pre>\n");
+        output.append("</div>\n");
+        output.flush();
+        return output.view();
     }
     
-    std::string printHtmlFromJson(const std::string& json_str, const std::string& title = "Colored JSON",
-                                 const std::string& background_color = "#1e1e1e",
-                                 const std::string& font_family = "Consolas, 'Courier New', monospace") {
-        output.str("");
-        output.clear();
-        indent_level = 0;
-        current_path = "";
+    std::string printHtmlFromJson(std::string_view json_str, std::string_view title = "Colored JSON",
+                                 std::string_view background_color = "#1e1e1e",
+                                 std::string_view font_family = "Consolas, 'Courier New', monospace") {
+        return std::string(renderHtmlFromJson(json_str, title, background_color, font_family));
+    }
+    
+    // Render een eerder opgenomen token tape (zelfde Style), zonder GIL
+    std::string_view renderTape(const TokenTape& tape, std::string_view title = "Colored JSON",
+                                std::string_view language = "json") {
+        reset();
+        writeTitle(title);
+        writeStyleSheet();
         
-        if (!title.empty()) {
-            output << "# " << title << "\n\n";
-        }
+        output.append("```");
+        output.append(language);
+        output.push_back('\n');
         
-        output << "<div style=\"background-color: " << background_color 
-               << "; color: #ffffff; font-family: " << font_family 
-               << "; padding: 20px; border-radius: 5px; overflow-x: auto;\">\n";
-        output << "<pre style=\"margin: 0; white-space: pre-wrap; word-wrap: break-word;\">";
+        renderTapeBody(tape);
         
-        try {
-            JsonParser parser;
-            auto doc = parser.parse(json_str);
-            ondemand::value val;
-            auto val_error = doc.get_value().get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get document value");
-            }
-            
-            ondemand::json_type type;
-            auto error = val.type().get(type);
-            if (error) {
-                throw std::runtime_error("Failed to get JSON type");
-            }
-            
-            if (type == ondemand::json_type::object) {
-                ondemand::object obj;
-                auto obj_error = val.get_object().get(obj);
-                if (obj_error) {
-                    throw std::runtime_error("Failed to get object");
-                }
-                printDictJson(obj, "");
-            } else if (type == ondemand::json_type::array) {
-                ondemand::array arr;
-                auto arr_error = val.get_array().get(arr);
-                if (arr_error) {
-                    throw std::runtime_error("Failed to get array");
-                }
-                printListJson(arr, "");
-            } else {
-                printValueJson(val, "");
-            }
-        } catch (const simdjson_error& e) {
-            throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
-        } catch (const std::exception& e) {
-            throw std::runtime_error("JSON processing error: " + std::string(e.what()));
-        }
+        output.append("\n```\n");
+        output.flush();
+        return output.view();
+    }
+    
+    std::string_view renderHtmlTape(const TokenTape& tape, std::string_view title = "Colored JSON",
+                                    std::string_view background_color = "#1e1e1e",
+                                    std::string_view font_family = "Consolas, 'Courier New', monospace") {
+        reset();
+        writeTitle(title);
+        writeStyleSheet();
+        writeHtmlBlockStart(background_color, font_family);
         
-        output << "</pre>\n";
-        output << "</div>\n";
+        renderTapeBody(tape);
         
-        return output.str();
+        output.append("</pre>\n");
+        output.append("</div>\n");
+        output.flush();
+        return output.view();
     }
 };
 
 } // namespace colored_json
-
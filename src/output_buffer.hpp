@@ -0,0 +1,254 @@
+#pragma once
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace colored_json {
+
+// Bestemming voor gerenderde output. Een OutputBuffer met een sink schrijft
+// zijn inhoud in blokken naar de sink in plaats van alles vast te houden.
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+    virtual void write(const char* data, size_t size) = 0;
+};
+
+// Schrijft naar een file descriptor (stdout, socket, pipe)
+class FdSink : public OutputSink {
+private:
+    int fd;
+
+public:
+    explicit FdSink(int fd_) : fd(fd_) {}
+
+    void write(const char* data, size_t size) override {
+        while (size > 0) {
+#ifdef _WIN32
+            int chunk = size > 0x7fffffff ? 0x7fffffff : static_cast<int>(size);
+            int written = ::_write(fd, data, chunk);
+#else
+            ssize_t written = ::write(fd, data, size);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Write to file descriptor failed: " + std::string(std::strerror(errno)));
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+};
+
+// Schrijft naar een C FILE* stream
+class FileSink : public OutputSink {
+private:
+    std::FILE* file;
+
+public:
+    explicit FileSink(std::FILE* file_) : file(file_) {}
+
+    void write(const char* data, size_t size) override {
+        if (std::fwrite(data, 1, size, file) != size) {
+            throw std::runtime_error("Write to file failed");
+        }
+    }
+};
+
+// Aaneengesloten, groeiende byte buffer waar de printers in schrijven.
+// Appends zijn een capaciteitscheck plus memcpy; er is geen iostream
+// formatting en de inhoud wordt niet nogmaals gekopieerd bij het ophalen
+// (view()). Met een sink wordt de buffer geleegd zodra er flush_threshold
+// bytes in staan, ook als hij (van een eerdere render) groter is, zodat het
+// geheugengebruik begrensd blijft.
+class OutputBuffer {
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    size_t limit_ = 0;  // Bruikbare ruimte: capacity_, met een sink hooguit flush_threshold
+    OutputSink* sink = nullptr;
+    size_t flush_threshold = 0;
+
+    // Inhoud die er al staat (bijv. de vorige render) valt nooit buiten de limiet
+    void resetLimit() {
+        limit_ = sink && flush_threshold < capacity_ ? flush_threshold : capacity_;
+        if (limit_ < size_) limit_ = size_;
+    }
+
+    void reallocate(size_t new_capacity) {
+        char* grown = static_cast<char*>(std::realloc(data_, new_capacity));
+        if (!grown) throw std::bad_alloc();
+        data_ = grown;
+        capacity_ = new_capacity;
+        resetLimit();
+    }
+
+    // Slow path van append: eerst naar de sink flushen, anders geometrisch groeien
+    void makeRoom(size_t extra) {
+        if (sink) {
+            flush();
+            resetLimit();
+            if (extra <= limit_) return;
+            // Eén blok groter dan flush_threshold (prepare()); daarna weer begrensd
+            if (extra > capacity_) reallocate(extra);
+            limit_ = extra;
+            return;
+        }
+        size_t wanted = size_ + extra;
+        size_t grown = capacity_ < 256 ? 256 : capacity_ + capacity_ / 2;
+        reallocate(grown > wanted ? grown : wanted);
+    }
+
+public:
+    OutputBuffer() = default;
+    ~OutputBuffer() { std::free(data_); }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    OutputBuffer(OutputBuffer&& other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_),
+          limit_(other.limit_), sink(other.sink), flush_threshold(other.flush_threshold) {
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = other.limit_ = 0;
+        other.sink = nullptr;
+    }
+
+    OutputBuffer& operator=(OutputBuffer&& other) noexcept {
+        if (this != &other) {
+            std::free(data_);
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            limit_ = other.limit_;
+            sink = other.sink;
+            flush_threshold = other.flush_threshold;
+            other.data_ = nullptr;
+            other.size_ = other.capacity_ = other.limit_ = 0;
+            other.sink = nullptr;
+        }
+        return *this;
+    }
+
+    void append(const char* s, size_t n) {
+        if (n > limit_ - size_) {
+            // Met een sink gaat een groot blok (bijv. een deel van een
+            // parallelle render) direct door, zonder de buffer te laten groeien
+            if (sink && n >= flush_threshold) {
+                flush();
+                sink->write(s, n);
+                return;
+            }
+            makeRoom(n);
+        } else if (n == 0) {
+            return;  // memcpy met een lege (nullptr) buffer vermijden
+        }
+        std::memcpy(data_ + size_, s, n);
+        size_ += n;
+    }
+
+    void append(std::string_view s) { append(s.data(), s.size()); }
+
+    void append(size_t count, char c) {
+        if (count > limit_ - size_) makeRoom(count);
+        std::memset(data_ + size_, c, count);
+        size_ += count;
+    }
+
+    void push_back(char c) {
+        if (size_ == limit_) makeRoom(1);
+        data_[size_++] = c;
+    }
+
+    // Schrijfruimte voor maximaal n bytes direct in de buffer (bijv. voor
+    // simdjson::minify); daarna commit() met het aantal geschreven bytes
+    char* prepare(size_t n) {
+        if (n > limit_ - size_) makeRoom(n);
+        return data_ + size_;
+    }
+
+    void commit(size_t n) { size_ += n; }
+
+    // Reserveer ruimte vooraf (bijv. op basis van de input grootte)
+    void reserve(size_t n) {
+        if (sink && n > flush_threshold) n = flush_threshold;
+        if (n > capacity_) reallocate(n);
+    }
+
+    void clear() {
+        size_ = 0;
+        resetLimit();
+    }
+
+    // Leeg de buffer en geef de capaciteit boven max_capacity bytes terug
+    void shrinkTo(size_t max_capacity) {
+        size_ = 0;
+        if (capacity_ <= max_capacity) return;
+        if (max_capacity == 0) {
+            std::free(data_);
+            data_ = nullptr;
+            capacity_ = limit_ = 0;
+        } else {
+            reallocate(max_capacity);
+        }
+    }
+
+    // Gooi alles na de eerste n bytes weg (zonder sink)
+    void truncate(size_t n) {
+        if (n < size_) size_ = n;
+    }
+
+    // Koppel een sink; de buffer flusht zodra er flush_size bytes in staan,
+    // ongeacht de capaciteit die hij al heeft
+    void setSink(OutputSink* s, size_t flush_size = 64 * 1024) {
+        sink = s;
+        flush_threshold = flush_size;
+        if (sink && capacity_ < flush_size) reallocate(flush_size);
+        resetLimit();
+    }
+
+    // Schrijf de huidige inhoud naar de sink (no-op zonder sink)
+    void flush() {
+        if (sink && size_ > 0) {
+            sink->write(data_, size_);
+            size_ = 0;
+        }
+    }
+
+    bool hasSink() const { return sink != nullptr; }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+    std::string str() const { return std::string(data_, size_); }
+};
+
+// Koppelt een sink aan een buffer zolang dit object bestaat
+class ScopedSink {
+private:
+    OutputBuffer& buffer;
+
+public:
+    ScopedSink(OutputBuffer& buffer_, OutputSink& sink, size_t flush_size = 64 * 1024) : buffer(buffer_) {
+        buffer.setSink(&sink, flush_size);
+    }
+    ~ScopedSink() { buffer.setSink(nullptr); }
+
+    ScopedSink(const ScopedSink&) = delete;
+    ScopedSink& operator=(const ScopedSink&) = delete;
+};
+
+} // namespace colored_json
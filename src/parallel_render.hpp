@@ -0,0 +1,239 @@
+#pragma once
+#include "style.hpp"
+#include "compiled_style.hpp"
+#include "output_buffer.hpp"
+#include "render_engine.hpp"
+#include "thread_pool.hpp"
+#include <simdjson.h>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace colored_json {
+
+// Kleinere documenten zijn op één thread sneller dan het opdelen
+constexpr size_t PARALLEL_MIN_BYTES = 1024 * 1024;
+// Minimale grootte van een deel; per thread komen er PARALLEL_CHUNKS_PER_THREAD
+constexpr size_t PARALLEL_MIN_CHUNK_BYTES = 64 * 1024;
+constexpr size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+// Maximale grootte van een deel: er staan hooguit threads delen tegelijk in
+// het geheugen, dus dit begrenst het geheugen van een streamende render
+constexpr size_t PARALLEL_MAX_CHUNK_BYTES = 4 * 1024 * 1024;
+
+namespace detail {
+
+// Aaneengesloten reeks kinderen van de root: [begin, end) in de input
+struct ChunkRange {
+    size_t begin;
+    size_t end;
+    size_t first_index;  // Positie van het eerste kind (voor array regels)
+};
+
+// Resultaat van een deel, gevuld door een worker
+struct ChunkResult {
+    OutputBuffer output;
+    ColorSlot run_after = NO_SLOT;  // Actieve kleur aan het einde van het deel
+    std::exception_ptr error;
+    std::atomic<bool> done{false};
+};
+
+// Verdeel de kinderen van de root in delen van ongeveer target bytes. De
+// ondemand iterator slaat elk kind over zonder het te renderen.
+inline std::vector<ChunkRange> splitRoot(simdjson::ondemand::value root, bool is_array,
+                                         const char* base, size_t target) {
+    std::vector<ChunkRange> chunks;
+    size_t chunk_begin = 0;
+    size_t chunk_first = 0;
+    size_t last_end = 0;
+    bool open = false;
+    size_t index = 0;
+    auto add = [&](size_t begin, size_t end) {
+        last_end = end;
+        if (!open) {
+            chunk_begin = begin;
+            chunk_first = index;
+            open = true;
+        }
+        if (end - chunk_begin >= target) {
+            chunks.push_back({chunk_begin, end, chunk_first});
+            open = false;
+        }
+        index++;
+    };
+
+    if (is_array) {
+        simdjson::ondemand::array arr;
+        if (root.get_array().get(arr)) throw std::runtime_error("Failed to get array");
+        for (auto element : arr) {
+            simdjson::ondemand::value val;
+            if (element.get(val)) throw std::runtime_error("Failed to get array element");
+            std::string_view raw;
+            if (val.raw_json().get(raw)) throw std::runtime_error("Failed to get array element");
+            size_t begin = static_cast<size_t>(raw.data() - base);
+            add(begin, begin + raw.size());
+        }
+    } else {
+        simdjson::ondemand::object obj;
+        if (root.get_object().get(obj)) throw std::runtime_error("Failed to get object");
+        for (auto field : obj) {
+            std::string_view key;
+            if (field.escaped_key().get(key)) throw std::runtime_error("Failed to get field value");
+            simdjson::ondemand::value val;
+            if (field.value().get(val)) throw std::runtime_error("Failed to get field value");
+            std::string_view raw;
+            if (val.raw_json().get(raw)) throw std::runtime_error("Failed to get field value");
+            // De key begint bij de quote vóór de escaped key
+            size_t begin = static_cast<size_t>(key.data() - 1 - base);
+            add(begin, static_cast<size_t>(raw.data() - base) + raw.size());
+        }
+    }
+    if (open) chunks.push_back({chunk_begin, last_end, chunk_first});
+    return chunks;
+}
+
+// Render de root container in part_count delen op de gedeelde pool en zet
+// de buffers op volgorde achter elkaar. render_part(c, output, emitter)
+// schrijft de kinderen van deel c, met separators ertussen, via emitter naar
+// output. Een worker begint met dezelfde emitter toestand (indent, actieve
+// kleur) als de sequentiële render op die plek, dus de output is byte voor
+// byte gelijk. Hooguit threads delen zijn tegelijk onderweg.
+template<typename P, typename Emitter, typename RenderPart>
+void renderRootParts(Emitter& out, const CompiledStyle& compiled, int indent_size, bool is_array,
+                     size_t part_count, size_t threads, RenderPart&& render_part) {
+    out.template fragment<P>(is_array ? Fragment::OpenBracket : Fragment::OpenBrace);
+    out.increaseIndent();
+    if (part_count > 0) {
+        out.template lineBreak<P>();
+    }
+
+    // Toestand waarmee een deel begint: na de newline van het eerste
+    // kind, of na de separator voor alle volgende delen
+    ColorSlot first_run = out.activeRun();
+    ColorSlot separator_run = P::color ? compiled.fragment(Fragment::Separator).after : NO_SLOT;
+
+    std::unique_ptr<ChunkResult[]> results(new ChunkResult[part_count]);
+    ThreadPool& pool = ThreadPool::shared();
+    auto renderChunk = [&](size_t c) {
+        ChunkResult& result = results[c];
+        try {
+            Emitter emitter(result.output, compiled, indent_size);
+            emitter.resume(1, c == 0 ? first_run : separator_run);
+            render_part(c, result.output, emitter);
+            result.run_after = emitter.activeRun();
+        } catch (...) {
+            result.error = std::current_exception();
+        }
+        result.done.store(true, std::memory_order_release);
+    };
+
+    // Begrenst het aantal actieve threads en de gebufferde output
+    size_t submitted = 0;
+    auto submitNext = [&] {
+        size_t c = submitted++;
+        pool.submit([&renderChunk, c] { renderChunk(c); });
+    };
+    auto waitFor = [&](size_t c) {
+        pool.helpUntil([&] { return results[c].done.load(std::memory_order_acquire); });
+    };
+
+    try {
+        while (submitted < part_count && submitted < threads) submitNext();
+        for (size_t c = 0; c < part_count; c++) {
+            waitFor(c);
+            ChunkResult& result = results[c];
+            if (result.error) std::rethrow_exception(result.error);
+            if (c > 0) out.template fragment<P>(Fragment::Separator);
+            out.appendRendered(result.output.view(), result.run_after);
+            result.output = OutputBuffer();
+            if (submitted < part_count) submitNext();
+        }
+    } catch (...) {
+        // Workers verwijzen naar deze stack frame; eerst alles laten afronden
+        for (size_t c = 0; c < submitted; c++) waitFor(c);
+        throw;
+    }
+
+    out.decreaseIndent();
+    if (part_count > 0) out.template lineBreak<P>();
+    out.template fragment<P>(is_array ? Fragment::CloseBracket : Fragment::CloseBrace);
+}
+
+} // namespace detail
+
+// Render een JSON document waarvan de root een grote array of object is op
+// meerdere threads. De kinderen van de root worden in delen opgesplitst en
+// elk deel wordt door een worker opnieuw geparst (detail::renderRootParts).
+// Kleine documenten, scalaire roots en threads == 1 gaan sequentieel.
+// parser wordt voor de root hergebruikt; threads is het aantal threads.
+template<typename Emitter>
+void renderJsonDocumentParallel(Emitter& out, const Style& style, const CompiledStyle& compiled,
+                                std::string_view json_str, simdjson::ondemand::parser& parser,
+                                size_t threads) {
+    try {
+        ParsedDocument doc(parser, json_str);
+        simdjson::ondemand::value root = doc.root();
+        simdjson::ondemand::json_type type;
+        if (root.type().get(type)) {
+            throw std::runtime_error("Failed to get JSON type");
+        }
+        bool is_array = type == simdjson::ondemand::json_type::array;
+        if (threads <= 1 || json_str.size() < PARALLEL_MIN_BYTES ||
+            (!is_array && type != simdjson::ondemand::json_type::object)) {
+            renderJsonValue(out, style, compiled, root);
+            return;
+        }
+
+        size_t target = json_str.size() / (threads * PARALLEL_CHUNKS_PER_THREAD);
+        if (target < PARALLEL_MIN_CHUNK_BYTES) target = PARALLEL_MIN_CHUNK_BYTES;
+        if (target > PARALLEL_MAX_CHUNK_BYTES) target = PARALLEL_MAX_CHUNK_BYTES;
+        const char* base = doc.data();
+        std::vector<detail::ChunkRange> chunks = detail::splitRoot(root, is_array, base, target);
+
+        withStylePolicy(style, compiled, [&](auto policy) {
+            using P = decltype(policy);
+            detail::renderRootParts<P>(out, compiled, style.indent_size, is_array, chunks.size(), threads,
+                                       [&](size_t c, OutputBuffer& output, Emitter& emitter) {
+                const detail::ChunkRange& range = chunks[c];
+                size_t length = range.end - range.begin;
+                simdjson::padded_string part(length + 2);
+                part.data()[0] = is_array ? '[' : '{';
+                std::memcpy(part.data() + 1, base + range.begin, length);
+                part.data()[length + 1] = is_array ? ']' : '}';
+
+                ParserPool::Lease part_parser = ParserPool::acquire(part.size());
+                simdjson::ondemand::document part_doc = part_parser->iterate(part);
+                output.reserve(length * 2);
+                RenderEngine<Emitter> engine(emitter, compiled, style.verbatim_strings);
+                if (is_array) {
+                    simdjson::ondemand::array arr;
+                    if (part_doc.get_array().get(arr)) throw std::runtime_error("Failed to get array");
+                    engine.template printElementsJson<P>(arr, range.first_index);
+                } else {
+                    simdjson::ondemand::object obj;
+                    if (part_doc.get_object().get(obj)) throw std::runtime_error("Failed to get object");
+                    engine.template printFieldsJson<P>(obj);
+                }
+            });
+        });
+        out.finish();
+    } catch (const simdjson::simdjson_error& e) {
+        throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("JSON processing error: " + std::string(e.what()));
+    }
+}
+
+// Met een parser van deze thread (ParserPool) en Style::threads
+template<typename Emitter>
+void renderJsonDocumentParallel(Emitter& out, const Style& style, const CompiledStyle& compiled,
+                                std::string_view json_str) {
+    ParserPool::Lease parser = ParserPool::acquire(json_str.size());
+    renderJsonDocumentParallel(out, style, compiled, json_str, *parser, resolveThreadCount(style.threads));
+}
+
+} // namespace colored_json
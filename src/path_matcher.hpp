@@ -0,0 +1,277 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace colored_json {
+
+// Index in de kleurtabel van een CompiledStyle. De eerste ELEMENT_TYPE_COUNT
+// slots horen bij de ElementType waarden, daarna volgen de individuele
+// key/value kleuren uit Style::key_colors en Style::value_colors.
+using ColorSlot = uint16_t;
+constexpr ColorSlot NO_SLOT = 0xFFFF;
+
+// Automaat voor de path regels uit Style::key_colors en Style::value_colors.
+// Een regel als "users[*].email" wordt opgesplitst in segmenten (key, index,
+// "*" voor elke key, "[*]" voor elke index) en alle regels samen worden vooraf
+// omgezet in een deterministische automaat. De printer houdt alleen de huidige
+// toestand bij en doet per afdaling één stap (één hash lookup); er wordt geen
+// pad tekst meer opgebouwd.
+class PathMatcher {
+public:
+    using State = uint32_t;
+    static constexpr State ROOT = 0;
+    static constexpr State DEAD = 1;  // Geen enkele regel kan nog matchen
+
+private:
+    struct Segment {
+        bool is_index = false;
+        bool wildcard = false;
+        std::string_view key;
+        size_t index = 0;
+    };
+
+    // Een regel die in een toestand eindigt; de meest specifieke wint
+    struct Match {
+        ColorSlot slot = NO_SLOT;
+        size_t literals = 0;
+        std::string_view rule;
+
+        bool beats(const Match& other) const {
+            if (other.slot == NO_SLOT) return true;
+            if (literals != other.literals) return literals > other.literals;
+            return rule < other.rule;
+        }
+    };
+
+    // Trie node met de segmenten van de regels (niet-deterministisch door wildcards)
+    struct Node {
+        std::map<std::string_view, size_t> keys;
+        std::map<size_t, size_t> indices;
+        size_t any_key = 0;    // 0 = geen kind (de root is nooit een kind)
+        size_t any_index = 0;
+        Match key_match;
+        Match value_match;
+    };
+
+    struct Transitions {
+        std::unordered_map<std::string_view, State> keys;
+        std::unordered_map<size_t, State> indices;
+        State any_key = DEAD;
+        State any_index = DEAD;
+        ColorSlot key_slot = NO_SLOT;
+        ColorSlot value_slot = NO_SLOT;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Transitions> states;
+
+    // "a.b[0][*].*" -> a, b, [0], [*], *. Ongeldige regels geven false.
+    static bool parse(std::string_view rule, std::vector<Segment>& segments) {
+        segments.clear();
+        size_t pos = 0;
+        bool expect_key = true;
+        while (pos < rule.size()) {
+            if (rule[pos] == '[') {
+                size_t end = rule.find(']', pos);
+                if (end == std::string_view::npos) return false;
+                std::string_view inner = rule.substr(pos + 1, end - pos - 1);
+                Segment seg;
+                seg.is_index = true;
+                if (inner == "*") {
+                    seg.wildcard = true;
+                } else {
+                    if (inner.empty()) return false;
+                    for (char c : inner) {
+                        if (c < '0' || c > '9') return false;
+                        seg.index = seg.index * 10 + static_cast<size_t>(c - '0');
+                    }
+                }
+                segments.push_back(seg);
+                pos = end + 1;
+                expect_key = false;
+                continue;
+            }
+            if (!expect_key) {
+                if (rule[pos] != '.') return false;
+                pos++;
+            }
+            size_t end = rule.find_first_of(".[", pos);
+            if (end == std::string_view::npos) end = rule.size();
+            Segment seg;
+            seg.key = rule.substr(pos, end - pos);
+            seg.wildcard = seg.key == "*";
+            segments.push_back(seg);
+            pos = end;
+            expect_key = false;
+        }
+        return !segments.empty();
+    }
+
+    // Kind node via een verwijzing in de ouder; eerst de index bepalen omdat
+    // emplace_back de ouder kan verplaatsen
+    template<typename Get>
+    size_t child(size_t parent, Get get) {
+        size_t existing = get(nodes[parent]);
+        if (existing != 0) return existing;
+        size_t created = nodes.size();
+        nodes.emplace_back();
+        get(nodes[parent]) = created;
+        return created;
+    }
+
+    // Subset constructie: elke toestand is een gesorteerde set trie nodes
+    State stateFor(std::vector<size_t> set, std::map<std::vector<size_t>, State>& known,
+                   std::vector<std::vector<size_t>>& pending) {
+        if (set.empty()) return DEAD;
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+        auto it = known.find(set);
+        if (it != known.end()) return it->second;
+        State id = static_cast<State>(states.size());
+        states.emplace_back();
+        known.emplace(set, id);
+        pending.push_back(std::move(set));
+        return id;
+    }
+
+    void build() {
+        std::map<std::vector<size_t>, State> known;
+        std::vector<std::vector<size_t>> pending;
+        states.resize(2);
+        known.emplace(std::vector<size_t>{0}, ROOT);
+        pending.push_back({0});
+        std::vector<size_t> any_keys, any_indices, target;
+
+        for (size_t next = 0; next < pending.size(); next++) {
+            // Kopie: stateFor kan pending laten groeien
+            std::vector<size_t> set = pending[next];
+            State id = known[set];
+
+            Match key_match, value_match;
+            any_keys.clear();
+            any_indices.clear();
+            for (size_t n : set) {
+                if (nodes[n].key_match.slot != NO_SLOT && nodes[n].key_match.beats(key_match)) key_match = nodes[n].key_match;
+                if (nodes[n].value_match.slot != NO_SLOT && nodes[n].value_match.beats(value_match)) value_match = nodes[n].value_match;
+                if (nodes[n].any_key) any_keys.push_back(nodes[n].any_key);
+                if (nodes[n].any_index) any_indices.push_back(nodes[n].any_index);
+            }
+
+            // Een letterlijke key gaat naar zijn eigen kinderen plus alle "*" kinderen
+            std::unordered_map<std::string_view, State> keys;
+            std::unordered_map<size_t, State> indices;
+            for (size_t n : set) {
+                for (const auto& entry : nodes[n].keys) {
+                    if (keys.count(entry.first)) continue;
+                    target = any_keys;
+                    for (size_t m : set) {
+                        auto found = nodes[m].keys.find(entry.first);
+                        if (found != nodes[m].keys.end()) target.push_back(found->second);
+                    }
+                    keys.emplace(entry.first, stateFor(target, known, pending));
+                }
+                for (const auto& entry : nodes[n].indices) {
+                    if (indices.count(entry.first)) continue;
+                    target = any_indices;
+                    for (size_t m : set) {
+                        auto found = nodes[m].indices.find(entry.first);
+                        if (found != nodes[m].indices.end()) target.push_back(found->second);
+                    }
+                    indices.emplace(entry.first, stateFor(target, known, pending));
+                }
+            }
+            State any_key = stateFor(any_keys, known, pending);
+            State any_index = stateFor(any_indices, known, pending);
+
+            Transitions& t = states[id];
+            t.keys = std::move(keys);
+            t.indices = std::move(indices);
+            t.any_key = any_key;
+            t.any_index = any_index;
+            t.key_slot = key_match.slot;
+            t.value_slot = value_match.slot;
+        }
+    }
+
+    void insert(const std::vector<Segment>& segments, std::string_view rule,
+                ColorSlot slot, bool is_key_rule) {
+        if (nodes.empty()) nodes.emplace_back();
+
+        size_t node = 0;
+        Match match;
+        match.slot = slot;
+        match.rule = rule;
+        for (const auto& seg : segments) {
+            if (!seg.wildcard) match.literals++;
+            if (seg.is_index && seg.wildcard) {
+                node = child(node, [](Node& n) -> size_t& { return n.any_index; });
+            } else if (seg.is_index) {
+                node = child(node, [&](Node& n) -> size_t& { return n.indices[seg.index]; });
+            } else if (seg.wildcard) {
+                node = child(node, [](Node& n) -> size_t& { return n.any_key; });
+            } else {
+                node = child(node, [&](Node& n) -> size_t& { return n.keys[seg.key]; });
+            }
+        }
+        Match& target = is_key_rule ? nodes[node].key_match : nodes[node].value_match;
+        if (match.beats(target)) target = match;
+    }
+
+public:
+    PathMatcher() : states(2) {}
+
+    // Regels worden als string_view bewaard; de teksten moeten blijven bestaan
+    // zolang de matcher gebruikt wordt. Na de laatste regel compile() aanroepen.
+    bool addRule(std::string_view rule, ColorSlot slot, bool is_key_rule) {
+        std::vector<Segment> segments;
+        if (!parse(rule, segments)) return false;
+        insert(segments, rule, slot, is_key_rule);
+        return true;
+    }
+
+    // De hele regel als één letterlijke key op het hoogste niveau, zodat
+    // "a.b" ook een key matcht die letterlijk "a.b" heet
+    void addRootKeyRule(std::string_view rule, ColorSlot slot, bool is_key_rule) {
+        Segment seg;
+        seg.key = rule;
+        insert({seg}, rule, slot, is_key_rule);
+    }
+
+    void compile() {
+        states.clear();
+        if (nodes.empty()) {
+            states.resize(2);
+            return;
+        }
+        build();
+        nodes.clear();
+        nodes.shrink_to_fit();
+    }
+
+    bool empty() const { return states.size() <= 2; }
+
+    State stepKey(State state, std::string_view key) const {
+        if (state == DEAD) return DEAD;
+        const Transitions& t = states[state];
+        auto it = t.keys.find(key);
+        return it != t.keys.end() ? it->second : t.any_key;
+    }
+
+    // Elementen van een array zonder pad (de root array) krijgen geen index
+    State stepIndex(State state, size_t index) const {
+        if (state == DEAD || state == ROOT) return state;
+        const Transitions& t = states[state];
+        auto it = t.indices.find(index);
+        return it != t.indices.end() ? it->second : t.any_index;
+    }
+
+    ColorSlot keySlot(State state) const { return states[state].key_slot; }
+    ColorSlot valueSlot(State state) const { return states[state].value_slot; }
+};
+
+} // namespace colored_json
@@ -0,0 +1,134 @@
+#pragma once
+#include "output_buffer.hpp"
+#include "json_parser.hpp"
+#include <simdjson.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace colored_json {
+
+// Platte JSON output voor ColorMode::Disabled: geen escape codes, alleen de
+// whitespace wordt herschikt. Strings en getallen gaan ongewijzigd van de
+// input naar de output, dus dit pad geeft dezelfde bytes als de printer
+// zolang strings niet opnieuw ge-escaped hoeven te worden.
+
+// Kan deze input plat geformatteerd worden? Alleen een object of array als
+// root (een scalaire root geeft de gewone foutmelding) en alleen als de
+// strings verbatim mogen of er geen enkele escape in de input staat.
+inline bool plainFormatApplies(std::string_view json, bool verbatim_strings) {
+    size_t start = json.find_first_not_of(" \n\r\t");
+    if (start == std::string_view::npos || (json[start] != '{' && json[start] != '[')) {
+        return false;
+    }
+    return verbatim_strings || json.find('\\') == std::string_view::npos;
+}
+
+// Volledige validatie met de DOM parser; de formatters hieronder gaan uit
+// van geldige JSON. Geeft false bij een getal buiten 64 bits: dat is geldige
+// JSON die alleen de DOM parser weigert, de aanroeper gebruikt dan de emitter.
+inline bool validateJson(simdjson::dom::parser& parser, std::string_view json) {
+    // Zonder kopie als de bytes na de input leesbaar zijn
+    auto error = parser.parse(json.data(), json.size(), !paddingReadable(json.data(), json.size())).error();
+    if (error == simdjson::BIGINT_ERROR) return false;
+    if (error) {
+        throw std::runtime_error(std::string("JSON parsing error: ") + simdjson::error_message(error));
+    }
+    return true;
+}
+
+// Compact: simdjson minify direct in de output buffer
+inline void appendMinifiedJson(OutputBuffer& out, std::string_view json) {
+    char* dst = out.prepare(json.size());
+    size_t written = 0;
+    auto error = simdjson::minify(json.data(), json.size(), dst, written);
+    if (error) {
+        throw std::runtime_error(std::string("JSON parsing error: ") + simdjson::error_message(error));
+    }
+    out.commit(written);
+}
+
+// Pretty: één lineaire scan over de input. Strings en scalars worden als
+// geheel gekopieerd (memchr naar de afsluitende quote), alleen rond de
+// structurele tekens wordt newline plus indent uit een slab geschreven.
+inline void appendPrettyJson(OutputBuffer& out, std::string_view json, size_t indent_size) {
+    constexpr size_t SLAB_LEVELS = 32;
+    const size_t slab_spaces = indent_size * SLAB_LEVELS;
+    const std::string slab = "\n" + std::string(slab_spaces, ' ');
+    auto lineBreak = [&](size_t depth) {
+        size_t spaces = depth * indent_size;
+        if (spaces <= slab_spaces) {
+            out.append(slab.data(), 1 + spaces);
+        } else {
+            out.append(slab);
+            out.append(spaces - slab_spaces, ' ');
+        }
+    };
+    auto isWhitespace = [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+
+    const char* p = json.data();
+    const char* end = p + json.size();
+    size_t depth = 0;
+    while (p < end) {
+        char c = *p;
+        switch (c) {
+            case ' ': case '\n': case '\r': case '\t':
+                p++;
+                break;
+            case '"': {
+                // Afsluitende quote: de eerste zonder oneven aantal backslashes ervoor
+                const char* q = p + 1;
+                for (;;) {
+                    q = static_cast<const char*>(std::memchr(q, '"', static_cast<size_t>(end - q)));
+                    if (!q) throw std::runtime_error("JSON parsing error: unclosed string");
+                    const char* b = q;
+                    while (b[-1] == '\\') b--;
+                    if ((q - b) % 2 == 0) break;
+                    q++;
+                }
+                out.append(p, static_cast<size_t>(q + 1 - p));
+                p = q + 1;
+                break;
+            }
+            case '{': case '[': {
+                const char* next = p + 1;
+                while (next < end && isWhitespace(*next)) next++;
+                if (next < end && *next == (c == '{' ? '}' : ']')) {
+                    out.push_back(c);
+                    out.push_back(*next);
+                    p = next + 1;
+                    break;
+                }
+                out.push_back(c);
+                lineBreak(++depth);
+                p++;
+                break;
+            }
+            case '}': case ']':
+                lineBreak(--depth);
+                out.push_back(c);
+                p++;
+                break;
+            case ',':
+                out.push_back(',');
+                lineBreak(depth);
+                p++;
+                break;
+            case ':':
+                out.append(": ", 2);
+                p++;
+                break;
+            default: {
+                // Getal, true, false of null: tot de volgende whitespace of structurele byte
+                const char* q = p + 1;
+                while (q < end && !isWhitespace(*q) && *q != ',' && *q != '}' && *q != ']') q++;
+                out.append(p, static_cast<size_t>(q - p));
+                p = q;
+                break;
+            }
+        }
+    }
+}
+
+} // namespace colored_json
@@ -1,499 +1,158 @@
 #pragma once
 #include "style.hpp"
-#include "json_parser.hpp"
+#include "compiled_style.hpp"
+#include "output_buffer.hpp"
+#include "emitters.hpp"
+#include "py_render_engine.hpp"
+#include "parallel_render.hpp"
+#include "plain_format.hpp"
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <simdjson.h>
-#include <sstream>
-#include <iomanip>
+#include <memory>
+#include <string_view>
 
 namespace py = pybind11;
-using namespace simdjson;
 
 namespace colored_json {
 
+// Eén JSON document als terminal output achteraan in out. Zonder kleur wordt
+// alleen de whitespace herschikt: minify of platte pretty print (met
+// validator als validatie). Minify schrijft in één keer, dus met een sink
+// gaat compacte output via de emitter zodat er in blokken geflusht wordt.
+// Input met getallen buiten 64 bits gaat ook via de emitter.
+inline void appendAnsiJson(OutputBuffer& out, const Style& style, const CompiledStyle& compiled,
+                           std::string_view json_str, simdjson::ondemand::parser& parser,
+                           simdjson::dom::parser& validator, size_t threads) {
+    if (!compiled.hasColor() && !(style.compact && out.hasSink()) &&
+        plainFormatApplies(json_str, style.verbatim_strings) &&
+        validateJson(validator, json_str)) {
+        if (style.compact) {
+            appendMinifiedJson(out, json_str);
+        } else {
+            appendPrettyJson(out, json_str, static_cast<size_t>(style.indent_size > 0 ? style.indent_size : 0));
+        }
+        return;
+    }
+    AnsiEmitter emitter(out, compiled, style.indent_size);
+    renderJsonDocumentParallel(emitter, style, compiled, json_str, parser, threads);
+}
+
+// Idem, met een eigen validator
+inline void appendAnsiJson(OutputBuffer& out, const Style& style, const CompiledStyle& compiled,
+                           std::string_view json_str, simdjson::ondemand::parser& parser,
+                           size_t threads) {
+    simdjson::dom::parser validator;
+    appendAnsiJson(out, style, compiled, json_str, parser, validator, threads);
+}
+
+// Terminal output: de gedeelde traversal met de AnsiEmitter. Een Printer is
+// bedoeld om te hergebruiken (één per thread): de output buffer, de
+// validator en de CompiledStyle blijven tussen renders staan en de parser
+// komt uit de ParserPool van de thread, dus na de eerste paar documenten
+// alloceert een render van een klein document niets meer. Een render leest
+// alleen een snapshot van de Style (Style::snapshot()), dus de Style mag
+// intussen op een andere thread gewijzigd worden.
 class Printer {
 private:
-    const Style& style;
-    std::stringstream output;
-    int indent_level = 0;
-    std::string current_path;  // Voor tracking van geneste keys
-    static constexpr const char* RESET = "\033[0m";
+    const Style* source;                 // Style van de aanroeper; nullptr bij een vaste snapshot
+    std::shared_ptr<const Style> style;  // Snapshot waarmee compiled gebouwd is
+    CompiledStyle compiled;  // Escape codes per slot, alleen na een Style wijziging opnieuw gebouwd
+    OutputBuffer output;
+    simdjson::dom::parser validator;  // Validatie voor het kleurloze pad
+    size_t max_capacity;
     
-    void increaseIndent() { indent_level++; }
-    void decreaseIndent() { indent_level--; }
+    // Geschatte output grootte t.o.v. de JSON input (escape codes per token)
+    static constexpr size_t OUTPUT_EXPANSION = 3;
     
-    void addIndent() {
-        if (!style.compact) {
-            output << std::string(indent_level * style.indent_size, ' ');
+    void reset() {
+        trim();
+        if (source) {
+            std::shared_ptr<const Style> current = source->snapshot();
+            if (current != style) {
+                compiled = CompiledStyle::ansi(*current);
+                style = std::move(current);
+            }
         }
+        output.clear();
     }
-    
-    void addNewline() {
-        if (!style.compact) {
-            output << "\n";
-        }
+
+public:
+    // max_capacity begrenst het geheugen dat tussen renders vastgehouden
+    // wordt (bytes per buffer, 0 = geen limiet), zie trim()
+    explicit Printer(const Style& s, size_t max_capacity_ = 0)
+        : Printer(s.snapshot(), max_capacity_) {
+        source = &s;
     }
     
-    template<typename T>
-    void addColored(const Color& color, const T& value) {
-        output << color.toAnsi(style.color_mode) << value << RESET;
-    }
+    // Met een vaste snapshot, bijv. voor een render op een andere thread
+    explicit Printer(std::shared_ptr<const Style> s, size_t max_capacity_ = 0)
+        : source(nullptr), style(std::move(s)), compiled(CompiledStyle::ansi(*style)),
+          max_capacity(max_capacity_) {}
     
-    void printString(const std::string& s) {
-        std::stringstream escaped;
-        
-        for (char c : s) {
-            if (c == '"') escaped << "\\\"";
-            else if (c == '\\') escaped << "\\\\";
-            else if (c == '\b') escaped << "\\b";
-            else if (c == '\f') escaped << "\\f";
-            else if (c == '\n') escaped << "\\n";
-            else if (c == '\r') escaped << "\\r";
-            else if (c == '\t') escaped << "\\t";
-            else if (static_cast<unsigned char>(c) < 0x20) {
-                escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                        << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-            }
-            else escaped << c;
-        }
-        
-        // Print quotes apart van de string content
-        addColored(style.string_quote_color, "\"");
-        addColored(style.string_color, escaped.str());
-        addColored(style.string_quote_color, "\"");
-    }
+    // Interne output buffer; koppel hier een OutputSink aan om te streamen
+    OutputBuffer& buffer() { return output; }
     
-    void printKey(const std::string& s, const std::string& path = "") {
-        std::stringstream escaped;
-        
-        for (char c : s) {
-            if (c == '"') escaped << "\\\"";
-            else if (c == '\\') escaped << "\\\\";
-            else if (c == '\b') escaped << "\\b";
-            else if (c == '\f') escaped << "\\f";
-            else if (c == '\n') escaped << "\\n";
-            else if (c == '\r') escaped << "\\r";
-            else if (c == '\t') escaped << "\\t";
-            else if (static_cast<unsigned char>(c) < 0x20) {
-                escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                        << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-            }
-            else escaped << c;
-        }
-        
-        // Check voor individuele key kleur
-        Color key_col = style.key_color;
-        Color quote_col = style.key_quote_color;
-        if (!style.key_colors.empty()) {
-            // Check exacte key match
-            auto it = style.key_colors.find(s);
-            if (it != style.key_colors.end()) {
-                key_col = it->second;
-            } else if (!path.empty()) {
-                // Check path-based match (bijv. "user.name")
-                auto path_it = style.key_colors.find(path);
-                if (path_it != style.key_colors.end()) {
-                    key_col = path_it->second;
-                }
-            }
-        }
-        
-        // Print quotes apart van de key content
-        addColored(quote_col, "\"");
-        addColored(key_col, escaped.str());
-        addColored(quote_col, "\"");
-    }
+    size_t maxCapacity() const { return max_capacity; }
+    void setMaxCapacity(size_t n) { max_capacity = n; }
     
-    void printDict(py::dict obj, const std::string& parent_path = "") {
-        if (obj.empty()) {
-            addColored(style.brace_color, "{}");
-            return;
-        }
-        
-        addColored(style.brace_color, "{");
-        increaseIndent();
-        
-        bool first = true;
-        for (auto item : obj) {
-            if (!first) {
-                addColored(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            // Key (altijd string in Python dicts)
-            std::string key_str = py::str(item.first);
-            std::string current_key_path = parent_path.empty() ? key_str : parent_path + "." + key_str;
-            
-            printKey(key_str, current_key_path);
-            
-            addColored(style.colon_color, ":");
-            if (!style.compact) output << " ";
-            
-            // Value
-            printValue(item.second, current_key_path);
-            first = false;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addColored(style.brace_color, "}");
+    // Geef buffers groter dan max_capacity terug, bijv. na een uitzonderlijk
+    // groot document (ook de vrije parsers van deze thread). De view van de
+    // vorige render is daarna ongeldig.
+    void trim() {
+        if (max_capacity == 0) return;
+        if (output.capacity() > max_capacity) output.shrinkTo(max_capacity);
+        ParserPool::trim(max_capacity);
+        if (validator.capacity() > max_capacity) validator = simdjson::dom::parser();
     }
     
-    void printList(py::list obj, const std::string& parent_path = "") {
-        if (obj.empty()) {
-            addColored(style.bracket_color, "[]");
-            return;
-        }
-        
-        addColored(style.bracket_color, "[");
-        increaseIndent();
-        
-        bool first = true;
-        int index = 0;
-        for (auto item : obj) {
-            if (!first) {
-                addColored(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            std::string item_path = parent_path.empty() ? "" : parent_path + "[" + std::to_string(index) + "]";
-            printValue(item, item_path);
-            first = false;
-            index++;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addColored(style.bracket_color, "]");
+    // Render naar de interne buffer. De view is geldig tot de volgende render;
+    // met een sink is alles al weggeschreven en is de view leeg.
+    std::string_view render(py::handle obj) {
+        reset();
+        AnsiEmitter emitter(output, compiled, style->indent_size);
+        renderPyObject(emitter, *style, compiled, obj);
+        output.flush();
+        return output.view();
     }
     
-    void printValue(py::handle obj, const std::string& path = "") {
-        // Check voor individuele value kleur op basis van path
-        Color value_color;
-        bool has_custom_color = false;
-        
-        if (!style.value_colors.empty() && !path.empty()) {
-            auto it = style.value_colors.find(path);
-            if (it != style.value_colors.end()) {
-                value_color = it->second;
-                has_custom_color = true;
-            }
-        }
-        
-        if (py::isinstance<py::str>(obj)) {
-            if (has_custom_color) {
-                std::string str_val = py::str(obj);
-                std::stringstream escaped;
-                for (char c : str_val) {
-                    if (c == '"') escaped << "\\\"";
-                    else if (c == '\\') escaped << "\\\\";
-                    else if (c == '\b') escaped << "\\b";
-                    else if (c == '\f') escaped << "\\f";
-                    else if (c == '\n') escaped << "\\n";
-                    else if (c == '\r') escaped << "\\r";
-                    else if (c == '\t') escaped << "\\t";
-                    else if (static_cast<unsigned char>(c) < 0x20) {
-                        escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                                << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-                    }
-                    else escaped << c;
-                }
-                // Print quotes apart voor custom colors
-                addColored(style.string_quote_color, "\"");
-                addColored(value_color, escaped.str());
-                addColored(style.string_quote_color, "\"");
-            } else {
-                printString(py::str(obj));
-            }
-        } else if (py::isinstance<py::dict>(obj)) {
-            printDict(py::reinterpret_borrow<py::dict>(obj), path);
-        } else if (py::isinstance<py::list>(obj)) {
-            printList(py::reinterpret_borrow<py::list>(obj), path);
-        } else if (py::isinstance<py::int_>(obj) || py::isinstance<py::float_>(obj)) {
-            if (has_custom_color) {
-                addColored(value_color, py::str(obj));
-            } else {
-                addColored(style.number_color, py::str(obj));
-            }
-        } else if (py::isinstance<py::bool_>(obj)) {
-            if (has_custom_color) {
-                addColored(value_color, py::str(obj));
-            } else {
-                addColored(style.bool_color, py::str(obj));
-            }
-        } else if (obj.is_none()) {
-            if (has_custom_color) {
-                addColored(value_color, "null");
-            } else {
-                addColored(style.null_color, "null");
-            }
-        } else {
-            // Fallback voor andere types
-            printString(py::str(obj));
-        }
-    }
-    
-public:
-    explicit Printer(const Style& s) : style(s) {}
-    
     std::string print(py::handle obj) {
-        output.str("");
-        output.clear();
-        indent_level = 0;
-        current_path = "";
-        
-        if (py::isinstance<py::dict>(obj)) {
-            printDict(py::reinterpret_borrow<py::dict>(obj), "");
-        } else if (py::isinstance<py::list>(obj)) {
-            printList(py::reinterpret_borrow<py::list>(obj), "");
-        } else {
-            printValue(obj, "");
-        }
-        
-        return output.str();
+        return std::string(render(obj));
     }
     
-    // JSON string versies (werken met simdjson::ondemand::value)
-    void printDictJson(ondemand::object obj, const std::string& parent_path = "") {
-        addColored(style.brace_color, "{");
-        increaseIndent();
-        
-        bool first = true;
-        bool empty = true;
-        for (auto field : obj) {
-            empty = false;
-            if (!first) {
-                addColored(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            // Key (altijd string in JSON objects)
-            std::string_view key_view = field.unescaped_key();
-            std::string key_str(key_view);
-            std::string current_key_path = parent_path.empty() ? key_str : parent_path + "." + key_str;
-            
-            printKey(key_str, current_key_path);
-            
-            addColored(style.colon_color, ":");
-            if (!style.compact) output << " ";
-            
-            // Value
-            ondemand::value val;
-            auto val_error = field.value().get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get field value");
-            }
-            printValueJson(val, current_key_path);
-            first = false;
-        }
-        
-        if (empty) {
-            decreaseIndent();
-            addColored(style.brace_color, "}");
-            return;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addColored(style.brace_color, "}");
+    // Render een eerder gemaakte snapshot van een Python object; raakt geen
+    // Python objecten aan en kan dus zonder GIL
+    std::string_view renderSnapshot(const SnapshotTree& tree) {
+        reset();
+        AnsiEmitter emitter(output, compiled, style->indent_size);
+        renderSnapshotParallel(emitter, *style, compiled, tree, resolveThreadCount(style->threads));
+        output.flush();
+        return output.view();
     }
     
-    void printListJson(ondemand::array arr, const std::string& parent_path = "") {
-        addColored(style.bracket_color, "[");
-        increaseIndent();
-        
-        bool first = true;
-        bool empty = true;
-        int index = 0;
-        for (auto element : arr) {
-            empty = false;
-            if (!first) {
-                addColored(style.comma_color, ",");
-            }
-            addNewline();
-            addIndent();
-            
-            std::string item_path = parent_path.empty() ? "" : parent_path + "[" + std::to_string(index) + "]";
-            ondemand::value val;
-            auto val_error = element.get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get array element");
-            }
-            printValueJson(val, item_path);
-            first = false;
-            index++;
-        }
-        
-        if (empty) {
-            decreaseIndent();
-            addColored(style.bracket_color, "]");
-            return;
-        }
-        
-        decreaseIndent();
-        addNewline();
-        addIndent();
-        addColored(style.bracket_color, "]");
+    std::string_view renderFromJson(std::string_view json_str) {
+        reset();
+        output.reserve(json_str.size() * (compiled.hasColor() ? OUTPUT_EXPANSION : (style->compact ? 1 : 2)));
+        ParserPool::Lease parser = ParserPool::acquire(json_str.size());
+        appendAnsiJson(output, *style, compiled, json_str, *parser, validator, resolveThreadCount(style->threads));
+        output.flush();
+        return output.view();
     }
     
-    void printValueJson(ondemand::value val, const std::string& path = "") {
-        // Check voor individuele value kleur op basis van path
-        Color value_color;
-        bool has_custom_color = false;
-        
-        if (!style.value_colors.empty() && !path.empty()) {
-            auto it = style.value_colors.find(path);
-            if (it != style.value_colors.end()) {
-                value_color = it->second;
-                has_custom_color = true;
-            }
-        }
-        
-        ondemand::json_type type;
-        auto type_error = val.type().get(type);
-        if (type_error) {
-            throw std::runtime_error("Failed to get JSON type");
-        }
-        
-        switch (type) {
-            case ondemand::json_type::string: {
-                std::string_view str_view;
-                auto str_error = val.get_string().get(str_view);
-                if (str_error) {
-                    throw std::runtime_error("Failed to get string value");
-                }
-                std::string str_val(str_view);
-                if (has_custom_color) {
-                    std::stringstream escaped;
-                    for (char c : str_val) {
-                        if (c == '"') escaped << "\\\"";
-                        else if (c == '\\') escaped << "\\\\";
-                        else if (c == '\b') escaped << "\\b";
-                        else if (c == '\f') escaped << "\\f";
-                        else if (c == '\n') escaped << "\\n";
-                        else if (c == '\r') escaped << "\\r";
-                        else if (c == '\t') escaped << "\\t";
-                        else if (static_cast<unsigned char>(c) < 0x20) {
-                            escaped << "\\u00" << std::hex << std::setfill('0') << std::setw(2) 
-                                    << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
-                        }
-                        else escaped << c;
-                    }
-                    addColored(style.string_quote_color, "\"");
-                    addColored(value_color, escaped.str());
-                    addColored(style.string_quote_color, "\"");
-                } else {
-                    printString(str_val);
-                }
-                break;
-            }
-            case ondemand::json_type::object: {
-                ondemand::object obj;
-                auto obj_error = val.get_object().get(obj);
-                if (obj_error) {
-                    throw std::runtime_error("Failed to get object");
-                }
-                printDictJson(obj, path);
-                break;
-            }
-            case ondemand::json_type::array: {
-                ondemand::array arr;
-                auto arr_error = val.get_array().get(arr);
-                if (arr_error) {
-                    throw std::runtime_error("Failed to get array");
-                }
-                printListJson(arr, path);
-                break;
-            }
-            case ondemand::json_type::number: {
-                std::string_view num_view = val.raw_json_token();
-                std::string num_str(num_view);
-                if (has_custom_color) {
-                    addColored(value_color, num_str);
-                } else {
-                    addColored(style.number_color, num_str);
-                }
-                break;
-            }
-            case ondemand::json_type::boolean: {
-                bool b;
-                auto bool_error = val.get_bool().get(b);
-                if (bool_error) {
-                    throw std::runtime_error("Failed to get boolean");
-                }
-                std::string bool_str = b ? "true" : "false";
-                if (has_custom_color) {
-                    addColored(value_color, bool_str);
-                } else {
-                    addColored(style.bool_color, bool_str);
-                }
-                break;
-            }
-            case ondemand::json_type::null: {
-                if (has_custom_color) {
-                    addColored(value_color, "null");
-                } else {
-                    addColored(style.null_color, "null");
-                }
-                break;
-            }
-        }
+    std::string printFromJson(std::string_view json_str) {
+        return std::string(renderFromJson(json_str));
     }
     
-    std::string printFromJson(const std::string& json_str) {
-        output.str("");
-        output.clear();
-        indent_level = 0;
-        current_path = "";
-        
-        try {
-            JsonParser parser;
-            auto doc = parser.parse(json_str);
-            ondemand::value val;
-            auto val_error = doc.get_value().get(val);
-            if (val_error) {
-                throw std::runtime_error("Failed to get document value");
-            }
-            
-            ondemand::json_type type;
-            auto error = val.type().get(type);
-            if (error) {
-                throw std::runtime_error("Failed to get JSON type");
-            }
-            
-            if (type == ondemand::json_type::object) {
-                ondemand::object obj;
-                auto obj_error = val.get_object().get(obj);
-                if (obj_error) {
-                    throw std::runtime_error("Failed to get object");
-                }
-                printDictJson(obj, "");
-            } else if (type == ondemand::json_type::array) {
-                ondemand::array arr;
-                auto arr_error = val.get_array().get(arr);
-                if (arr_error) {
-                    throw std::runtime_error("Failed to get array");
-                }
-                printListJson(arr, "");
-            } else {
-                printValueJson(val, "");
-            }
-        } catch (const simdjson_error& e) {
-            throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
-        } catch (const std::exception& e) {
-            throw std::runtime_error("JSON processing error: " + std::string(e.what()));
-        }
-        
-        return output.str();
+    // Render een eerder opgenomen token tape (zelfde Style); raakt geen
+    // Python objecten aan en kan dus zonder GIL
+    std::string_view renderTape(const TokenTape& tape) {
+        reset();
+        output.reserve(tape.tokens().size() * 16);
+        AnsiEmitter emitter(output, compiled, style->indent_size);
+        colored_json::renderTape(emitter, *style, compiled, tape);
+        output.flush();
+        return output.view();
     }
 };
 
 } // namespace colored_json
-
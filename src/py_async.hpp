@@ -0,0 +1,203 @@
+#pragma once
+#include "py_output.hpp"
+#include "py_render_engine.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace colored_json {
+
+// Input van een async render, gemaakt met de GIL: JSON zonder kopie
+// (JsonInput) of een snapshot van een Python object. Daarna is hij zonder
+// GIL te lezen; vernietigen weer met de GIL.
+class AsyncInput {
+private:
+    std::unique_ptr<JsonInput> json_;
+    SnapshotTree tree;
+
+public:
+    AsyncInput(py::handle obj, bool is_json) {
+        if (is_json) {
+            json_ = std::make_unique<JsonInput>(obj);
+        } else {
+            tree = snapshotFromPython(obj);
+        }
+    }
+
+    bool isJson() const { return json_ != nullptr; }
+    std::string_view json() const { return json_->view(); }
+    const SnapshotTree& snapshot() const { return tree; }
+};
+
+namespace detail {
+
+// Aantal lopende async jobs. Bij het afsluiten van de interpreter wordt erop
+// gewacht (waitForAsyncJobs), zodat geen worker na Py_Finalize de GIL pakt.
+class AsyncJobCounter {
+private:
+    std::mutex mutex;
+    std::condition_variable idle;
+    size_t running = 0;
+
+public:
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        running++;
+    }
+
+    void finish() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) idle.notify_all();
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [&] { return running == 0; });
+    }
+
+    // Bewust nooit vernietigd, net als ThreadPool::shared()
+    static AsyncJobCounter& instance() {
+        static AsyncJobCounter* counter = new AsyncJobCounter();
+        return *counter;
+    }
+};
+
+// Eigen pool voor async jobs. Een job wacht aan het einde op de GIL; in
+// ThreadPool::shared() zou een synchrone render (helpUntil) hem kunnen
+// stelen en zo op de GIL blijven wachten. Bewust nooit vernietigd.
+inline ThreadPool& asyncPool() {
+    static ThreadPool* pool = new ThreadPool(resolveThreadCount(0));
+    return *pool;
+}
+
+template<typename Render>
+struct AsyncJob {
+    py::object loop;
+    py::object future;
+    py::object resolve;  // resolve(future, value, failed) op de event loop thread
+    Render render;       // Zonder GIL uitgevoerd; de view blijft geldig tot de job vernietigd is
+    bool as_bytes;
+};
+
+// Zet het resultaat of de fout van een job via loop.call_soon_threadsafe in
+// de future; met de GIL. Lukt het omzetten van het resultaat niet (bijv.
+// ongeldige UTF-8), dan krijgt de future die fout. Alleen een gesloten event
+// loop wordt genegeerd: dan wacht niemand meer op de future.
+template<typename Job>
+void resolveAsyncJob(Job& job, std::string_view result, PyObject* error_type, const std::string& error) {
+    py::object value;
+    bool failed = error_type != nullptr;
+    try {
+        if (failed) {
+            PyObject* exception = PyObject_CallFunction(error_type, "s", error.c_str());
+            if (!exception) throw py::error_already_set();
+            value = py::reinterpret_steal<py::object>(exception);
+        } else if (job.as_bytes) {
+            value = py::bytes(result.data(), result.size());
+        } else {
+            value = toPyStr(result);
+        }
+    } catch (py::error_already_set& e) {
+        value = e.value();
+        failed = true;
+    } catch (const std::exception& e) {
+        value = py::reinterpret_steal<py::object>(PyObject_CallFunction(PyExc_RuntimeError, "s", e.what()));
+        failed = true;
+    }
+
+    // Tweede poging met de fout van call_soon_threadsafe zelf
+    for (int attempt = 0; attempt < 2; attempt++) {
+        try {
+            job.loop.attr("call_soon_threadsafe")(job.resolve, job.future, value, failed);
+            return;
+        } catch (py::error_already_set& e) {
+            try {
+                if (e.matches(PyExc_RuntimeError) && job.loop.attr("is_closed")().template cast<bool>()) return;
+            } catch (py::error_already_set& closed_error) {
+                closed_error.discard_as_unraisable("colored_json async resolve");
+            }
+            if (attempt == 1) {
+                e.discard_as_unraisable("colored_json async resolve");
+                return;
+            }
+            value = e.value();
+            failed = true;
+        }
+    }
+}
+
+// Taak op asyncPool(): renderen zonder GIL, daarna met de GIL afronden
+template<typename Job>
+void runAsyncJob(Job* raw) {
+    std::string_view result;
+    std::string error;
+    PyObject* error_type = nullptr;
+    try {
+        result = raw->render();
+    } catch (const std::bad_alloc&) {
+        error_type = PyExc_MemoryError;
+        error = "Out of memory";
+    } catch (const std::exception& e) {
+        error_type = PyExc_RuntimeError;
+        error = e.what();
+    } catch (...) {
+        error_type = PyExc_RuntimeError;
+        error = "Unknown error";
+    }
+
+    {
+        py::gil_scoped_acquire acquire;
+        std::unique_ptr<Job> job(raw);
+        resolveAsyncJob(*job, result, error_type, error);
+    }
+    AsyncJobCounter::instance().finish();
+}
+
+} // namespace detail
+
+// Wacht (zonder GIL) tot alle async jobs klaar zijn; de module registreert
+// dit als atexit handler
+inline void waitForAsyncJobs() {
+    py::gil_scoped_release release;
+    detail::AsyncJobCounter::instance().waitIdle();
+}
+
+// Voer render uit op de async pool van de module en geef een asyncio future
+// van de lopende event loop terug. render draait zonder GIL en geeft een view
+// op zijn output; de future krijgt die als str (of bytes met as_bytes), of
+// de exception. Een geannuleerde future wordt overgeslagen. render en alles
+// wat hij vasthoudt wordt met de GIL vernietigd. Aanroepen met de GIL.
+template<typename Render>
+py::object submitAsync(Render render, bool as_bytes) {
+    py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+    py::object future = loop.attr("create_future")();
+    py::object resolve = py::cpp_function([](py::object target, py::object value, bool failed) {
+        if (target.attr("done")().cast<bool>()) return;
+        target.attr(failed ? "set_exception" : "set_result")(value);
+    });
+
+    using Job = detail::AsyncJob<Render>;
+    std::unique_ptr<Job> job(new Job{loop, future, std::move(resolve), std::move(render), as_bytes});
+    Job* raw = job.get();
+    detail::AsyncJobCounter::instance().start();
+    try {
+        detail::asyncPool().submit([raw] { detail::runAsyncJob(raw); });
+    } catch (...) {
+        detail::AsyncJobCounter::instance().finish();
+        throw;
+    }
+    job.release();
+    return future;
+}
+
+} // namespace colored_json
@@ -0,0 +1,190 @@
+#pragma once
+#include "output_buffer.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+#include <climits>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace colored_json {
+
+// Geeft elk blok als bytes door aan een Python callable (bijv. file.write),
+// of als str voor een tekstbestand (text). Een UTF-8 sequentie die over de
+// blokgrens valt wordt bewaard tot het volgende blok. Mag ook zonder GIL
+// aangeroepen worden; de GIL wordt per blok opgepakt. Een Python exception
+// uit de callable wordt bewaard en stopt de render met een runtime_error;
+// rethrowError() gooit hem daarna (met de GIL) opnieuw.
+class PyCallbackSink : public OutputSink {
+private:
+    py::object callback;
+    bool text;
+    std::string pending;  // Onvolledige UTF-8 sequentie aan het einde van het vorige blok
+    std::exception_ptr error;
+
+    void writeText(const char* data, size_t size) {
+        if (!pending.empty()) {
+            pending.append(data, size);
+            data = pending.data();
+            size = pending.size();
+        }
+        Py_ssize_t consumed = 0;
+        PyObject* chunk = PyUnicode_DecodeUTF8Stateful(data, static_cast<Py_ssize_t>(size), "strict", &consumed);
+        if (!chunk) throw py::error_already_set();
+        std::string rest(data + consumed, size - static_cast<size_t>(consumed));
+        callback(py::reinterpret_steal<py::object>(chunk));
+        pending = std::move(rest);
+    }
+
+public:
+    explicit PyCallbackSink(py::object callback_, bool text_ = false)
+        : callback(std::move(callback_)), text(text_) {}
+
+    void write(const char* data, size_t size) override {
+        py::gil_scoped_acquire acquire;
+        try {
+            if (text) {
+                writeText(data, size);
+            } else {
+                callback(py::bytes(data, size));
+            }
+        } catch (py::error_already_set&) {
+            error = std::current_exception();
+            throw std::runtime_error("Write to Python file object failed");
+        }
+    }
+
+    void rethrowError() {
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+};
+
+// Bestemming van dump() en Printer.print_to(): een int is een file
+// descriptor en wordt zonder GIL beschreven; anders gaat elk blok naar
+// file.write, als str voor een tekstbestand (io.TextIOBase) en anders als
+// bytes. Maken met de GIL.
+class PyOutputTarget {
+private:
+    std::unique_ptr<FdSink> fd_sink;
+    std::unique_ptr<PyCallbackSink> callback_sink;
+
+public:
+    explicit PyOutputTarget(py::handle file) {
+        if (PyLong_Check(file.ptr()) && !PyBool_Check(file.ptr())) {
+            long fd = PyLong_AsLong(file.ptr());
+            if (fd == -1 && PyErr_Occurred()) throw py::error_already_set();
+            if (fd < 0 || fd > INT_MAX) throw py::value_error("Invalid file descriptor: " + std::to_string(fd));
+            fd_sink = std::make_unique<FdSink>(static_cast<int>(fd));
+            return;
+        }
+        PyObject* write = PyObject_GetAttrString(file.ptr(), "write");
+        if (!write) throw py::error_already_set();
+        py::object callback = py::reinterpret_steal<py::object>(write);
+        if (!PyCallable_Check(callback.ptr())) throw py::type_error("file.write is not callable");
+
+        PyObject* io = PyImport_ImportModule("io");
+        if (!io) throw py::error_already_set();
+        py::object io_module = py::reinterpret_steal<py::object>(io);
+        PyObject* text_base = PyObject_GetAttrString(io_module.ptr(), "TextIOBase");
+        if (!text_base) throw py::error_already_set();
+        py::object text_type = py::reinterpret_steal<py::object>(text_base);
+        int is_text = PyObject_IsInstance(file.ptr(), text_type.ptr());
+        if (is_text < 0) throw py::error_already_set();
+        callback_sink = std::make_unique<PyCallbackSink>(std::move(callback), is_text == 1);
+    }
+
+    OutputSink& sink() {
+        if (fd_sink) return *fd_sink;
+        return *callback_sink;
+    }
+
+    // Na een mislukte render: de Python exception van file.write, als die er is
+    void rethrowError() {
+        if (callback_sink) callback_sink->rethrowError();
+    }
+};
+
+// Python str direct uit de render buffer, zonder tussenliggende std::string
+inline py::str toPyStr(std::string_view view) {
+    return py::str(view.data(), view.size());
+}
+
+// Resultaat naar Python zonder str: als bytes (as_bytes), of geschreven in
+// een schrijfbare buffer van de aanroeper (into: bytearray, memoryview, ...)
+// met het aantal bytes als resultaat. Een te kleine bytearray wordt vergroot;
+// een te kleine andere buffer geeft een ValueError. Anders een str.
+inline py::object toPyResult(std::string_view view, bool as_bytes, py::handle into) {
+    if (!into.is_none()) {
+        if (PyByteArray_Check(into.ptr()) && static_cast<size_t>(PyByteArray_GET_SIZE(into.ptr())) < view.size()) {
+            if (PyByteArray_Resize(into.ptr(), static_cast<Py_ssize_t>(view.size())) != 0) {
+                throw py::error_already_set();
+            }
+        }
+        Py_buffer buffer;
+        if (PyObject_GetBuffer(into.ptr(), &buffer, PyBUF_WRITABLE) != 0) throw py::error_already_set();
+        if (static_cast<size_t>(buffer.len) < view.size()) {
+            Py_ssize_t available = buffer.len;
+            PyBuffer_Release(&buffer);
+            throw py::value_error("Output buffer too small: " + std::to_string(view.size()) +
+                                  " bytes needed, " + std::to_string(available) + " available");
+        }
+        std::memcpy(buffer.buf, view.data(), view.size());
+        PyBuffer_Release(&buffer);
+        return py::int_(view.size());
+    }
+    if (as_bytes) {
+        return py::bytes(view.data(), view.size());
+    }
+    return toPyStr(view);
+}
+
+// JSON input uit een Python object zonder kopie: de UTF-8 data van een str
+// of de buffer van bytes, bytearray, memoryview, ... (buffer protocol). De
+// buffer blijft vastgehouden tot het object vernietigd wordt, dus een
+// bytearray kan intussen niet van grootte veranderen. Maken en vernietigen
+// met de GIL; de view is ook zonder GIL te gebruiken.
+class JsonInput {
+private:
+    py::object owner;
+    Py_buffer buffer{};
+    bool has_buffer = false;
+    std::string_view view_;
+
+public:
+    explicit JsonInput(py::handle obj) : owner(py::reinterpret_borrow<py::object>(obj)) {
+        if (PyUnicode_Check(obj.ptr())) {
+            Py_ssize_t size = 0;
+            const char* data = PyUnicode_AsUTF8AndSize(obj.ptr(), &size);
+            if (!data) throw py::error_already_set();
+            view_ = std::string_view(data, static_cast<size_t>(size));
+        } else if (PyObject_CheckBuffer(obj.ptr())) {
+            if (PyObject_GetBuffer(obj.ptr(), &buffer, PyBUF_SIMPLE) != 0) throw py::error_already_set();
+            has_buffer = true;
+            view_ = std::string_view(static_cast<const char*>(buffer.buf), static_cast<size_t>(buffer.len));
+        } else {
+            throw py::type_error("JSON input must be str, bytes, bytearray or memoryview");
+        }
+    }
+
+    JsonInput(JsonInput&& other) noexcept
+        : owner(std::move(other.owner)), buffer(other.buffer), has_buffer(other.has_buffer), view_(other.view_) {
+        other.has_buffer = false;
+    }
+
+    JsonInput(const JsonInput&) = delete;
+    JsonInput& operator=(const JsonInput&) = delete;
+    JsonInput& operator=(JsonInput&&) = delete;
+
+    ~JsonInput() {
+        if (has_buffer) PyBuffer_Release(&buffer);
+    }
+
+    std::string_view view() const { return view_; }
+};
+
+} // namespace colored_json
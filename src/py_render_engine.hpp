@@ -0,0 +1,163 @@
+#pragma once
+#include "render_engine.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+#include "token_tape.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+#include <charconv>
+#include <memory>
+#include <string_view>
+
+namespace py = pybind11;
+
+namespace colored_json {
+
+// Kopieert Python objecten (dict, list, scalars) naar een SnapshotTree; moet
+// met de GIL. Exacte types gaan direct via de C API; subclasses en overige
+// objecten via str(), net als de tekst die voorheen per node gemaakt werd.
+class PySnapshotBuilder {
+private:
+    SnapshotTree& tree;
+
+    // Cycli geven een RecursionError in plaats van een stack overflow
+    struct RecursionGuard {
+        RecursionGuard() {
+            if (Py_EnterRecursiveCall(" while rendering a Python object")) throw py::error_already_set();
+        }
+        ~RecursionGuard() { Py_LeaveRecursiveCall(); }
+    };
+
+    // Free-threaded Python: de container is gelockt tijdens het itereren, zodat
+    // een andere thread hem intussen niet kan wijzigen (no-op met GIL)
+    struct CriticalSection {
+#ifdef Py_GIL_DISABLED
+        PyCriticalSection section;
+        explicit CriticalSection(PyObject* obj) { PyCriticalSection_Begin(&section, obj); }
+        ~CriticalSection() { PyCriticalSection_End(&section); }
+#else
+        explicit CriticalSection(PyObject*) {}
+#endif
+    };
+
+    // UTF-8 van een str (ook een subclass); geldig zolang het object leeft
+    static std::string_view utf8(PyObject* s) {
+        Py_ssize_t size = 0;
+        const char* data = PyUnicode_AsUTF8AndSize(s, &size);
+        if (!data) throw py::error_already_set();
+        return std::string_view(data, static_cast<size_t>(size));
+    }
+
+    void leafStr(SnapshotKind kind, std::string_view key, PyObject* obj) {
+        py::str text(py::handle(obj).str());
+        tree.leaf(kind, key, utf8(text.ptr()));
+    }
+
+    void addDict(PyObject* obj, std::string_view key) {
+        size_t index = tree.open(SnapshotKind::Object, key);
+        CriticalSection lock(obj);
+        Py_ssize_t pos = 0;
+        PyObject* k = nullptr;
+        PyObject* v = nullptr;
+        while (PyDict_Next(obj, &pos, &k, &v)) {
+            // Eigen referenties: str() van een key kan Python code draaien
+            py::object key_ref = py::reinterpret_borrow<py::object>(k);
+            py::object value_ref = py::reinterpret_borrow<py::object>(v);
+            if (PyUnicode_Check(k)) {
+                add(v, utf8(k));
+            } else {
+                py::str key_str(key_ref.str());
+                add(v, utf8(key_str.ptr()));
+            }
+        }
+        tree.close(index);
+    }
+
+    void addList(PyObject* obj, std::string_view key) {
+        size_t index = tree.open(SnapshotKind::Array, key);
+        CriticalSection lock(obj);
+        for (Py_ssize_t i = 0; i < PyList_GET_SIZE(obj); i++) {
+            py::object item = py::reinterpret_borrow<py::object>(PyList_GET_ITEM(obj, i));
+            add(item.ptr(), {});
+        }
+        tree.close(index);
+    }
+
+    void addInt(PyObject* obj, std::string_view key) {
+        int overflow = 0;
+        long long value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+        if (overflow != 0 || (value == -1 && PyErr_Occurred())) {
+            PyErr_Clear();
+            leafStr(SnapshotKind::Number, key, obj);
+            return;
+        }
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        tree.leaf(SnapshotKind::Number, key, std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+    }
+
+    // Zelfde tekst als str(float)
+    void addFloat(PyObject* obj, std::string_view key) {
+        std::unique_ptr<char, void (*)(void*)> repr(
+            PyOS_double_to_string(PyFloat_AS_DOUBLE(obj), 'r', 0, Py_DTSF_ADD_DOT_0, nullptr), PyMem_Free);
+        if (!repr) throw py::error_already_set();
+        tree.leaf(SnapshotKind::Number, key, repr.get());
+    }
+
+public:
+    explicit PySnapshotBuilder(SnapshotTree& t) : tree(t) {}
+
+    // Volgorde van de checks als in Python: bool is een int subclass en komt
+    // dus als "True"/"False" in de getal kleur
+    void add(PyObject* obj, std::string_view key) {
+        RecursionGuard guard;
+        if (PyUnicode_Check(obj)) {
+            tree.leaf(SnapshotKind::String, key, utf8(obj));
+        } else if (PyDict_Check(obj)) {
+            addDict(obj, key);
+        } else if (PyList_Check(obj)) {
+            addList(obj, key);
+        } else if (PyLong_CheckExact(obj)) {
+            addInt(obj, key);
+        } else if (obj == Py_True || obj == Py_False) {
+            tree.leaf(SnapshotKind::Number, key, obj == Py_True ? "True" : "False");
+        } else if (PyFloat_CheckExact(obj)) {
+            addFloat(obj, key);
+        } else if (PyLong_Check(obj) || PyFloat_Check(obj)) {
+            leafStr(SnapshotKind::Number, key, obj);
+        } else if (obj == Py_None) {
+            tree.leaf(SnapshotKind::Null, key, {});
+        } else {
+            leafStr(SnapshotKind::Other, key, obj);
+        }
+    }
+};
+
+inline SnapshotTree snapshotFromPython(py::handle obj) {
+    SnapshotTree tree;
+    PySnapshotBuilder builder(tree);
+    builder.add(obj.ptr(), {});
+    return tree;
+}
+
+// Render een Python object met emitter out. De objecten worden met de GIL
+// gekopieerd; het renderen zelf gebeurt zonder GIL en bij een groot object
+// op Style::threads threads.
+template<typename Emitter>
+void renderPyObject(Emitter& out, const Style& style, const CompiledStyle& compiled, py::handle obj) {
+    SnapshotTree tree = snapshotFromPython(obj);
+    py::gil_scoped_release release;
+    renderSnapshotParallel(out, style, compiled, tree, resolveThreadCount(style.threads));
+}
+
+// Neem een Python object op als token tape (kopiëren met de GIL)
+inline TokenTape tapeFromPython(py::handle obj, const Style& style) {
+    SnapshotTree tree = snapshotFromPython(obj);
+    TokenTape tape;
+    tape.record(style, [&](TapeEmitter& emitter, const CompiledStyle& compiled) {
+        renderSnapshot(emitter, style, compiled, tree);
+    });
+    return tape;
+}
+
+} // namespace colored_json
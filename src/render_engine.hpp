@@ -0,0 +1,304 @@
+#pragma once
+#include "style.hpp"
+#include "compiled_style.hpp"
+#include "emitters.hpp"
+#include "render_policy.hpp"
+#include "json_parser.hpp"
+#include <simdjson.h>
+#include <stdexcept>
+#include <string_view>
+
+namespace colored_json {
+
+// Eén traversal voor alle outputformaten. De engine loopt door het document,
+// houdt de positie in de key/value regels bij en geeft elk token door aan de
+// emitter (ANSI, HTML, ...). Geen pybind11 afhankelijkheid, zodat wjq en de
+// Python module dezelfde code delen; py_render_engine.hpp voegt de traversal
+// van Python objecten toe.
+template<typename Emitter>
+class RenderEngine {
+protected:
+    Emitter& out;
+    const CompiledStyle& compiled;
+    bool verbatim_strings;
+    PathMatcher::State match_state = PathMatcher::ROOT;  // Positie in de key/value regels
+
+    template<typename P>
+    void enterKey(std::string_view key) {
+        if constexpr (P::rules) match_state = compiled.paths().stepKey(match_state, key);
+    }
+
+    template<typename P>
+    void enterIndex(size_t index) {
+        if constexpr (P::rules) match_state = compiled.paths().stepIndex(match_state, index);
+    }
+
+    // Individuele key kleur (exacte key match gaat voor path match); de matcher
+    // moet de stap naar de key al gezet hebben
+    template<typename P>
+    ColorSlot keySlot(std::string_view key) const {
+        if constexpr (P::rules) {
+            return compiled.keySlot(key, match_state);
+        } else {
+            return slotOf(ElementType::Key);
+        }
+    }
+
+    // Individuele value kleur op basis van de huidige matcher toestand, of fallback
+    template<typename P>
+    ColorSlot valueSlot(ElementType fallback) const {
+        if constexpr (P::rules) {
+            ColorSlot slot = compiled.valueSlot(match_state);
+            if (slot != NO_SLOT) return slot;
+        }
+        return slotOf(fallback);
+    }
+
+    // Quotes en inhoud apart gekleurd
+    template<typename P>
+    void printString(std::string_view s, ColorSlot slot) {
+        out.template fragment<P>(Fragment::StringQuote);
+        out.template escapedToken<P>(slot, s);
+        out.template fragment<P>(Fragment::StringQuote);
+    }
+
+    template<typename P>
+    void printKey(std::string_view s, ColorSlot key_slot) {
+        out.template fragment<P>(Fragment::KeyQuote);
+        out.template escapedToken<P>(key_slot, s);
+        out.template fragment<P>(Fragment::KeyQuote);
+    }
+
+    // Verbatim variant: raw is de al ge-escapete tekst uit de JSON input
+    template<typename P>
+    void printRaw(Fragment quote, std::string_view raw, ColorSlot slot) {
+        out.template fragment<P>(quote);
+        out.template token<P>(slot, raw);
+        out.template fragment<P>(quote);
+    }
+
+    // Eén veld van een object: key, colon en value (zonder scheiding ervoor)
+    template<typename P>
+    void printFieldJson(simdjson::simdjson_result<simdjson::ondemand::field>& field) {
+        // Key (altijd string in JSON objects)
+        std::string_view key_view;
+        std::string_view key_text;  // Gedecodeerde key voor de key/value regels
+        if (verbatim_strings) {
+            key_view = field.escaped_key();
+            key_text = key_view;
+            // Alleen decoderen als een regel de tekst nodig heeft
+            if (P::rules && key_view.find('\\') != std::string_view::npos) {
+                key_text = field.unescaped_key();
+            }
+        } else {
+            key_view = field.unescaped_key();
+            key_text = key_view;
+        }
+        PathMatcher::State parent_state = match_state;
+        enterKey<P>(key_text);
+
+        if (verbatim_strings) {
+            printRaw<P>(Fragment::KeyQuote, key_view, keySlot<P>(key_text));
+        } else {
+            printKey<P>(key_view, keySlot<P>(key_text));
+        }
+
+        out.template fragment<P>(Fragment::Colon);
+
+        // Value
+        simdjson::ondemand::value val;
+        auto val_error = field.value().get(val);
+        if (val_error) {
+            throw std::runtime_error("Failed to get field value");
+        }
+        printValueJson<P>(val);
+        match_state = parent_state;
+    }
+
+    // Eén element van een array op positie index
+    template<typename P>
+    void printElementJson(simdjson::simdjson_result<simdjson::ondemand::value>& element, size_t index) {
+        PathMatcher::State parent_state = match_state;
+        enterIndex<P>(index);
+        simdjson::ondemand::value val;
+        auto val_error = element.get(val);
+        if (val_error) {
+            throw std::runtime_error("Failed to get array element");
+        }
+        printValueJson<P>(val);
+        match_state = parent_state;
+    }
+
+public:
+    RenderEngine(Emitter& emitter, const CompiledStyle& c, bool verbatim)
+        : out(emitter), compiled(c), verbatim_strings(verbatim) {}
+
+    template<typename P>
+    void printDictJson(simdjson::ondemand::object obj) {
+        out.template fragment<P>(Fragment::OpenBrace);
+        out.increaseIndent();
+
+        bool first = true;
+        for (auto field : obj) {
+            if (first) {
+                out.template lineBreak<P>();
+            } else {
+                out.template fragment<P>(Fragment::Separator);
+            }
+            printFieldJson<P>(field);
+            first = false;
+        }
+
+        out.decreaseIndent();
+        if (!first) out.template lineBreak<P>();
+        out.template fragment<P>(Fragment::CloseBrace);
+    }
+
+    template<typename P>
+    void printListJson(simdjson::ondemand::array arr) {
+        out.template fragment<P>(Fragment::OpenBracket);
+        out.increaseIndent();
+
+        bool first = true;
+        size_t index = 0;
+        for (auto element : arr) {
+            if (first) {
+                out.template lineBreak<P>();
+            } else {
+                out.template fragment<P>(Fragment::Separator);
+            }
+            printElementJson<P>(element, index);
+            first = false;
+            index++;
+        }
+
+        out.decreaseIndent();
+        if (!first) out.template lineBreak<P>();
+        out.template fragment<P>(Fragment::CloseBracket);
+    }
+
+    // Alleen de velden van een object, met separators ertussen maar zonder
+    // accolades of newline ervoor (een deel van de root, parallel_render.hpp)
+    template<typename P>
+    void printFieldsJson(simdjson::ondemand::object obj) {
+        bool first = true;
+        for (auto field : obj) {
+            if (!first) out.template fragment<P>(Fragment::Separator);
+            printFieldJson<P>(field);
+            first = false;
+        }
+    }
+
+    // Idem voor elementen van een array; first_index is de positie van het
+    // eerste element in de hele array
+    template<typename P>
+    void printElementsJson(simdjson::ondemand::array arr, size_t first_index) {
+        size_t index = first_index;
+        for (auto element : arr) {
+            if (index != first_index) out.template fragment<P>(Fragment::Separator);
+            printElementJson<P>(element, index);
+            index++;
+        }
+    }
+
+    template<typename P>
+    void printValueJson(simdjson::ondemand::value val) {
+        simdjson::ondemand::json_type type;
+        auto type_error = val.type().get(type);
+        if (type_error) {
+            throw std::runtime_error("Failed to get JSON type");
+        }
+
+        switch (type) {
+            case simdjson::ondemand::json_type::string: {
+                ColorSlot slot = valueSlot<P>(ElementType::String);
+                if (verbatim_strings) {
+                    // Al geldige escapes direct uit de input kopiëren
+                    printRaw<P>(Fragment::StringQuote, rawStringContent(val.raw_json_token()), slot);
+                    break;
+                }
+                std::string_view str_view;
+                auto str_error = val.get_string().get(str_view);
+                if (str_error) {
+                    throw std::runtime_error("Failed to get string value");
+                }
+                printString<P>(str_view, slot);
+                break;
+            }
+            case simdjson::ondemand::json_type::object: {
+                simdjson::ondemand::object obj;
+                auto obj_error = val.get_object().get(obj);
+                if (obj_error) {
+                    throw std::runtime_error("Failed to get object");
+                }
+                printDictJson<P>(obj);
+                break;
+            }
+            case simdjson::ondemand::json_type::array: {
+                simdjson::ondemand::array arr;
+                auto arr_error = val.get_array().get(arr);
+                if (arr_error) {
+                    throw std::runtime_error("Failed to get array");
+                }
+                printListJson<P>(arr);
+                break;
+            }
+            case simdjson::ondemand::json_type::number: {
+                std::string_view num_view = trimRawToken(val.raw_json_token());
+                out.template token<P>(valueSlot<P>(ElementType::Number), num_view);
+                break;
+            }
+            case simdjson::ondemand::json_type::boolean: {
+                bool b;
+                auto bool_error = val.get_bool().get(b);
+                if (bool_error) {
+                    throw std::runtime_error("Failed to get boolean");
+                }
+                out.template token<P>(valueSlot<P>(ElementType::Boolean), b ? "true" : "false");
+                break;
+            }
+            case simdjson::ondemand::json_type::null: {
+                out.template token<P>(valueSlot<P>(ElementType::Null), "null");
+                break;
+            }
+        }
+    }
+};
+
+// Policy voor een render: compact, kleur en regels liggen vast per CompiledStyle
+template<typename Fn>
+decltype(auto) withStylePolicy(const Style& style, const CompiledStyle& compiled, Fn&& fn) {
+    return withRenderPolicy(style.compact, compiled.hasColor(), compiled.hasRules(),
+                            std::forward<Fn>(fn));
+}
+
+// Render de root value van een JSON document met emitter out. Een scalaire
+// root wordt net als een value in een container geschreven.
+template<typename Emitter>
+void renderJsonValue(Emitter& out, const Style& style, const CompiledStyle& compiled,
+                     simdjson::ondemand::value val) {
+    RenderEngine<Emitter> engine(out, compiled, style.verbatim_strings);
+    withStylePolicy(style, compiled, [&](auto policy) {
+        engine.template printValueJson<decltype(policy)>(val);
+    });
+    out.finish();
+}
+
+// Parse json_str met een parser van deze thread en render het document;
+// fouten worden runtime_errors met de bekende "JSON parsing error" / "JSON
+// processing error" prefix
+template<typename Emitter>
+void renderJsonDocument(Emitter& out, const Style& style, const CompiledStyle& compiled,
+                        std::string_view json_str) {
+    try {
+        ParserPool::Lease parser = ParserPool::acquire(json_str.size());
+        ParsedDocument doc(*parser, json_str);
+        renderJsonValue(out, style, compiled, doc.root());
+    } catch (const simdjson::simdjson_error& e) {
+        throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("JSON processing error: " + std::string(e.what()));
+    }
+}
+
+} // namespace colored_json
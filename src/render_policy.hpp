@@ -0,0 +1,36 @@
+#pragma once
+#include <utility>
+
+namespace colored_json {
+
+// Compile-time variant van een render: compact of pretty, met of zonder kleur,
+// met of zonder key/value regels. De printer kiest eenmalig per aanroep de
+// juiste instantiatie, zodat de inner loops deze vlaggen niet meer per token
+// hoeven te controleren.
+template<bool CompactV, bool ColorV, bool RulesV>
+struct RenderPolicy {
+    static constexpr bool compact = CompactV;
+    static constexpr bool color = ColorV;
+    static constexpr bool rules = RulesV;
+};
+
+// Roep fn aan met de RenderPolicy die bij de runtime vlaggen hoort
+template<typename Fn>
+decltype(auto) withRenderPolicy(bool compact, bool color, bool rules, Fn&& fn) {
+    if (compact) {
+        if (color) {
+            if (rules) return fn(RenderPolicy<true, true, true>{});
+            return fn(RenderPolicy<true, true, false>{});
+        }
+        if (rules) return fn(RenderPolicy<true, false, true>{});
+        return fn(RenderPolicy<true, false, false>{});
+    }
+    if (color) {
+        if (rules) return fn(RenderPolicy<false, true, true>{});
+        return fn(RenderPolicy<false, true, false>{});
+    }
+    if (rules) return fn(RenderPolicy<false, false, true>{});
+    return fn(RenderPolicy<false, false, false>{});
+}
+
+} // namespace colored_json
@@ -0,0 +1,202 @@
+#pragma once
+#include "style.hpp"
+#include "compiled_style.hpp"
+#include "render_engine.hpp"
+#include "parallel_render.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace colored_json {
+
+enum class SnapshotKind : uint8_t {
+    Object,
+    Array,
+    String,
+    Number,
+    Null,
+    Other  // Overig object als str(), altijd in de string kleur
+};
+
+// Eén node in pre-order. Een kind van een object heeft zijn key direct voor
+// de tekst in de arena staan.
+struct SnapshotNode {
+    SnapshotKind kind;
+    size_t key_length;
+    size_t offset;  // Begin van key en tekst in de arena
+    size_t length;  // Lengte van de tekst
+    size_t end;     // Index van de eerste node na deze subtree
+};
+
+// Kopie van een object graph (Python dicts en lists, py_render_engine.hpp)
+// als vlakke boom met alle tekst in één arena. Raakt na het opbouwen geen
+// Python objecten meer aan, dus renderen kan zonder GIL en parallel.
+class SnapshotTree {
+private:
+    std::string arena;
+    std::vector<SnapshotNode> nodes_;
+
+    size_t push(SnapshotKind kind, std::string_view key, std::string_view text) {
+        size_t index = nodes_.size();
+        nodes_.push_back({kind, key.size(), arena.size(), text.size(), index + 1});
+        arena.append(key.data(), key.size());
+        arena.append(text.data(), text.size());
+        return index;
+    }
+
+public:
+    // Opbouwen in pre-order: open() en close() rond de kinderen van een container
+    size_t open(SnapshotKind kind, std::string_view key) { return push(kind, key, {}); }
+    void close(size_t index) { nodes_[index].end = nodes_.size(); }
+    void leaf(SnapshotKind kind, std::string_view key, std::string_view text) { push(kind, key, text); }
+
+    const std::vector<SnapshotNode>& nodes() const { return nodes_; }
+
+    std::string_view key(const SnapshotNode& node) const {
+        return std::string_view(arena.data() + node.offset, node.key_length);
+    }
+
+    std::string_view text(const SnapshotNode& node) const {
+        return std::string_view(arena.data() + node.offset + node.key_length, node.length);
+    }
+
+    // Geschatte output grootte van de nodes [begin, end), zonder kleur
+    size_t weight(size_t begin, size_t end) const {
+        size_t text_end = end < nodes_.size() ? nodes_[end].offset : arena.size();
+        return text_end - nodes_[begin].offset + (end - begin) * NODE_BYTES;
+    }
+
+    // Geschatte bytes per node voor indent, quotes en separators
+    static constexpr size_t NODE_BYTES = 8;
+};
+
+// Traversal van een SnapshotTree; dezelfde tokens als de directe traversal
+// van de Python objecten
+template<typename Emitter>
+class SnapshotRenderEngine : public RenderEngine<Emitter> {
+private:
+    using Base = RenderEngine<Emitter>;
+    using Base::out;
+    using Base::match_state;
+
+    const SnapshotTree& tree;
+
+public:
+    SnapshotRenderEngine(Emitter& emitter, const CompiledStyle& c, const SnapshotTree& t)
+        : Base(emitter, c, false), tree(t) {}
+
+    // De kinderen [begin, end) van een container, met separators ertussen
+    // maar zonder haakjes of newline ervoor; first_index is de positie van
+    // het eerste kind in een array
+    template<typename P>
+    void printChildren(bool is_object, size_t begin, size_t end, size_t first_index) {
+        const std::vector<SnapshotNode>& nodes = tree.nodes();
+        size_t index = first_index;
+        for (size_t child = begin; child < end; child = nodes[child].end) {
+            if (child != begin) out.template fragment<P>(Fragment::Separator);
+            PathMatcher::State parent_state = match_state;
+            if (is_object) {
+                std::string_view key = tree.key(nodes[child]);
+                this->template enterKey<P>(key);
+                this->template printKey<P>(key, this->template keySlot<P>(key));
+                out.template fragment<P>(Fragment::Colon);
+            } else {
+                this->template enterIndex<P>(index);
+            }
+            printNode<P>(child);
+            match_state = parent_state;
+            index++;
+        }
+    }
+
+    template<typename P>
+    void printNode(size_t i) {
+        const SnapshotNode& node = tree.nodes()[i];
+        switch (node.kind) {
+            case SnapshotKind::Object:
+            case SnapshotKind::Array: {
+                bool is_object = node.kind == SnapshotKind::Object;
+                if (node.end == i + 1) {
+                    out.template fragment<P>(is_object ? Fragment::EmptyBrace : Fragment::EmptyBracket);
+                    break;
+                }
+                out.template fragment<P>(is_object ? Fragment::OpenBrace : Fragment::OpenBracket);
+                out.increaseIndent();
+                out.template lineBreak<P>();
+                printChildren<P>(is_object, i + 1, node.end, 0);
+                out.decreaseIndent();
+                out.template lineBreak<P>();
+                out.template fragment<P>(is_object ? Fragment::CloseBrace : Fragment::CloseBracket);
+                break;
+            }
+            case SnapshotKind::String:
+                this->template printString<P>(tree.text(node), this->template valueSlot<P>(ElementType::String));
+                break;
+            case SnapshotKind::Number:
+                out.template token<P>(this->template valueSlot<P>(ElementType::Number), tree.text(node));
+                break;
+            case SnapshotKind::Null:
+                out.template token<P>(this->template valueSlot<P>(ElementType::Null), "null");
+                break;
+            case SnapshotKind::Other:
+                this->template printString<P>(tree.text(node), slotOf(ElementType::String));
+                break;
+        }
+    }
+};
+
+// Render een snapshot met emitter out
+template<typename Emitter>
+void renderSnapshot(Emitter& out, const Style& style, const CompiledStyle& compiled,
+                    const SnapshotTree& tree) {
+    if (tree.nodes().empty()) return;
+    SnapshotRenderEngine<Emitter> engine(out, compiled, tree);
+    withStylePolicy(style, compiled, [&](auto policy) {
+        engine.template printNode<decltype(policy)>(0);
+    });
+    out.finish();
+}
+
+// Idem, met een grote root array of object net als een JSON document
+// verdeeld over threads (parallel_render.hpp)
+template<typename Emitter>
+void renderSnapshotParallel(Emitter& out, const Style& style, const CompiledStyle& compiled,
+                            const SnapshotTree& tree, size_t threads) {
+    const std::vector<SnapshotNode>& nodes = tree.nodes();
+    if (nodes.empty()) return;
+    const SnapshotNode& root = nodes[0];
+    bool is_container = root.kind == SnapshotKind::Object || root.kind == SnapshotKind::Array;
+    if (threads <= 1 || !is_container || root.end == 1 || tree.weight(0, nodes.size()) < PARALLEL_MIN_BYTES) {
+        renderSnapshot(out, style, compiled, tree);
+        return;
+    }
+
+    // Kinderen van de root in delen van ongeveer target bytes
+    size_t target = tree.weight(0, nodes.size()) / (threads * PARALLEL_CHUNKS_PER_THREAD);
+    if (target < PARALLEL_MIN_CHUNK_BYTES) target = PARALLEL_MIN_CHUNK_BYTES;
+    if (target > PARALLEL_MAX_CHUNK_BYTES) target = PARALLEL_MAX_CHUNK_BYTES;
+    std::vector<detail::ChunkRange> chunks;
+    size_t index = 0;
+    for (size_t child = 1; child < root.end; child = nodes[child].end, index++) {
+        if (chunks.empty() || tree.weight(chunks.back().begin, chunks.back().end) >= target) {
+            chunks.push_back({child, child, index});
+        }
+        chunks.back().end = nodes[child].end;
+    }
+
+    bool is_array = root.kind == SnapshotKind::Array;
+    withStylePolicy(style, compiled, [&](auto policy) {
+        using P = decltype(policy);
+        detail::renderRootParts<P>(out, compiled, style.indent_size, is_array, chunks.size(), threads,
+                                   [&](size_t c, OutputBuffer& output, Emitter& emitter) {
+            const detail::ChunkRange& range = chunks[c];
+            output.reserve(tree.weight(range.begin, range.end) * 2);
+            SnapshotRenderEngine<Emitter> engine(emitter, compiled, tree);
+            engine.template printChildren<P>(!is_array, range.begin, range.end, range.first_index);
+        });
+    });
+    out.finish();
+}
+
+} // namespace colored_json
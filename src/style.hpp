@@ -1,5 +1,8 @@
 #pragma once
 #include "color.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -21,7 +24,30 @@ enum class ElementType {
     Bracket,    // [ ]
     Colon,
     Comma,
-    Whitespace // Alleen voor indented mode
+    Whitespace, // Alleen voor indented mode
+    KeyQuote,   // " rond keys
+    StringQuote // " rond strings
+};
+
+constexpr size_t ELEMENT_TYPE_COUNT = static_cast<size_t>(ElementType::StringQuote) + 1;
+
+struct Style;
+
+// Lock, versie en laatste snapshot van een Style. Elke wijziging via
+// Style::modify() verhoogt de versie; de snapshot hoort bij frozen_version.
+// Een kopie van de Style krijgt een eigen, lege guard.
+struct StyleGuard {
+    std::mutex mutex;
+    std::shared_ptr<const Style> frozen;
+    uint64_t version = 0;
+    uint64_t frozen_version = 0;
+    
+    StyleGuard() = default;
+    StyleGuard(const StyleGuard&) {}
+    StyleGuard& operator=(const StyleGuard&) {
+        frozen.reset();
+        return *this;
+    }
 };
 
 struct Style {
@@ -45,20 +71,101 @@ struct Style {
     ColorMode color_mode = ColorMode::Auto;
     bool compact = false;
     int indent_size = 2;
+    // JSON input: strings en keys ongewijzigd (nog ge-escaped) uit de input
+    // kopiëren in plaats van unescapen en opnieuw escapen
+    bool verbatim_strings = false;
+    // HTML/Markdown: korte class per span plus één <style> blok in plaats van
+    // een inline style attribuut op elke span
+    bool css_classes = false;
+    // Threads voor grote JSON documenten (root array of object): 0 = alle
+    // cores, 1 = altijd sequentieel
+    int threads = 0;
     
-    // Helper functies voor individuele kleuren
+    // Lees onder de lock van deze Style
+    template<typename Fn>
+    decltype(auto) locked(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(guard.mutex);
+        return fn();
+    }
+    
+    // Wijzig onder de lock en verhoog de versie. Wijzigingen vanuit Python
+    // gaan hierlangs, zodat een gelijktijdige snapshot() op een andere
+    // thread altijd een consistente kopie maakt.
+    template<typename Fn>
+    decltype(auto) modify(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(guard.mutex);
+        guard.version++;
+        return fn();
+    }
+    
+    // Helper functies voor individuele kleuren (onder de lock)
     void setKeyColor(const std::string& key, const Color& color) {
-        key_colors[key] = color;
+        modify([&] { key_colors[key] = color; });
     }
     
     void setValueColor(const std::string& path, const Color& color) {
-        value_colors[path] = color;
+        modify([&] { value_colors[path] = color; });
     }
     
+    // Onveranderlijke kopie voor een render. Zolang de versie niet veranderd
+    // is delen alle renders dezelfde snapshot (één versie check, los van het
+    // aantal regels); een render leest alleen de snapshot, dus een wijziging
+    // tijdens de render heeft er geen invloed op. Na de eerste snapshot()
+    // alleen via modify() wijzigen, anders blijft de oude snapshot in gebruik.
+    std::shared_ptr<const Style> snapshot() const;
+    
+    // Kleur voor een element type (Whitespace heeft geen eigen kleur)
+    Color elementColor(ElementType type) const;
+    
+    // Alle velden gelijk; een printer bouwt zijn CompiledStyle alleen opnieuw
+    // als de Style sinds de vorige render gewijzigd is
+    bool operator==(const Style& o) const;
+    bool operator!=(const Style& o) const { return !(*this == o); }
+    
     static Style getPreset(const std::string& name);
     static std::vector<std::string> listPresets();
+    
+private:
+    mutable StyleGuard guard;
 };
 
+inline Color Style::elementColor(ElementType type) const {
+    switch (type) {
+        case ElementType::Key:         return key_color;
+        case ElementType::String:      return string_color;
+        case ElementType::Number:      return number_color;
+        case ElementType::Boolean:     return bool_color;
+        case ElementType::Null:        return null_color;
+        case ElementType::Brace:       return brace_color;
+        case ElementType::Bracket:     return bracket_color;
+        case ElementType::Colon:       return colon_color;
+        case ElementType::Comma:       return comma_color;
+        case ElementType::KeyQuote:    return key_quote_color;
+        case ElementType::StringQuote: return string_quote_color;
+        case ElementType::Whitespace:  break;
+    }
+    return Color{};
+}
+
+inline bool Style::operator==(const Style& o) const {
+    for (size_t i = 0; i < ELEMENT_TYPE_COUNT; i++) {
+        ElementType type = static_cast<ElementType>(i);
+        if (elementColor(type) != o.elementColor(type)) return false;
+    }
+    return key_colors == o.key_colors && value_colors == o.value_colors &&
+           color_mode == o.color_mode && compact == o.compact && indent_size == o.indent_size &&
+           verbatim_strings == o.verbatim_strings && css_classes == o.css_classes && threads == o.threads;
+}
+
+inline std::shared_ptr<const Style> Style::snapshot() const {
+    std::lock_guard<std::mutex> lock(guard.mutex);
+    if (!guard.frozen || guard.frozen_version != guard.version) {
+        guard.frozen = std::make_shared<const Style>(*this);
+        guard.frozen_version = guard.version;
+    }
+    return guard.frozen;
+}
+
 inline Style Style::getPreset(const std::string& name) {
     Style s;
     
@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace colored_json {
+
+// Aantal render threads voor een gevraagd aantal: 0 (of negatief) = alle cores
+inline size_t resolveThreadCount(int threads) {
+    if (threads > 0) return static_cast<size_t>(threads);
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores > 0 ? cores : 1;
+}
+
+// Work-stealing thread pool: elke worker heeft een eigen deque. Een worker
+// neemt eerst het laatst toegevoegde werk van zijn eigen deque en steelt
+// anders het oudste werk van een andere deque. Een thread die op een
+// resultaat wacht (helpUntil) voert intussen zelf taken uit, dus er is altijd
+// voortgang, ook met weinig of geen vrije workers.
+// Taken mogen geen exceptions gooien; vang ze in de taak zelf op.
+class ThreadPool {
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex state_mutex;
+    std::condition_variable state_changed;  // Nieuw werk of een afgeronde taak
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> next_queue{0};
+    bool stopping = false;
+
+    static constexpr size_t NO_QUEUE = static_cast<size_t>(-1);
+
+    // Index van de eigen deque als de huidige thread een worker van deze pool is
+    size_t ownQueue() const {
+        return current_pool() == this ? current_index() : NO_QUEUE;
+    }
+
+    static const ThreadPool*& current_pool() {
+        static thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t& current_index() {
+        static thread_local size_t index = NO_QUEUE;
+        return index;
+    }
+
+    void notifyAll() {
+        { std::lock_guard<std::mutex> lock(state_mutex); }
+        state_changed.notify_all();
+    }
+
+    // Voer één taak uit: eerst van de eigen deque (achterkant), anders gestolen
+    // van de voorkant van een andere deque
+    bool tryRun(size_t self) {
+        std::function<void()> task;
+        if (self != NO_QUEUE) {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (size_t i = 0; !task && i < queues.size(); i++) {
+            size_t victim = self == NO_QUEUE ? i : (self + 1 + i) % queues.size();
+            Queue& other = *queues[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.tasks.empty()) {
+                task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+        pending--;
+        // Ook als de taak toch een exception gooit moeten wachters wakker worden
+        struct NotifyOnExit {
+            ThreadPool& pool;
+            ~NotifyOnExit() { pool.notifyAll(); }
+        } notify{*this};
+        task();
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        current_pool() = this;
+        current_index() = index;
+        for (;;) {
+            if (tryRun(index)) continue;
+            std::unique_lock<std::mutex> lock(state_mutex);
+            state_changed.wait(lock, [&] { return stopping || pending.load() > 0; });
+            if (stopping && pending.load() == 0) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threads) {
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; i++) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; i++) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            stopping = true;
+        }
+        state_changed.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Vanuit een worker op de eigen deque, anders round-robin verdeeld
+    void submit(std::function<void()> task) {
+        size_t target = ownQueue();
+        if (target == NO_QUEUE) target = next_queue++ % queues.size();
+        // Eerst tellen, dan publiceren: een dief die de taak meteen pakt mag
+        // pending nooit onder nul laten lopen
+        pending++;
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        notifyAll();
+    }
+
+    // Blokkeer tot done() true is en voer intussen taken uit
+    template<typename Pred>
+    void helpUntil(Pred done) {
+        size_t self = ownQueue();
+        while (!done()) {
+            if (tryRun(self)) continue;
+            std::unique_lock<std::mutex> lock(state_mutex);
+            state_changed.wait(lock, [&] { return done() || pending.load() > 0; });
+        }
+    }
+
+    // Gedeelde pool voor de hele module, één worker per extra core. Bewust
+    // nooit vernietigd: bij het afsluiten van het proces (of het unloaden van
+    // de extension) worden geen threads gejoind.
+    static ThreadPool& shared() {
+        static ThreadPool* pool = new ThreadPool(resolveThreadCount(0) > 1 ? resolveThreadCount(0) - 1 : 1);
+        return *pool;
+    }
+};
+
+} // namespace colored_json
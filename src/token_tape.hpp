@@ -0,0 +1,300 @@
+#pragma once
+#include "style.hpp"
+#include "compiled_style.hpp"
+#include "render_engine.hpp"
+#include <simdjson.h>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace colored_json {
+
+enum class TokenKind : uint8_t {
+    ObjectStart,
+    ObjectEnd,
+    ArrayStart,
+    ArrayEnd,
+    Key,
+    String,
+    Number,
+    Boolean,
+    Null
+};
+
+// Tekst van het token moet nog JSON-escaped worden (gedecodeerde string)
+constexpr uint8_t TOKEN_ESCAPE = 1;
+// Tekst staat in de arena van de tape in plaats van in de input
+constexpr uint8_t TOKEN_ARENA = 2;
+// Lege container die als één fragment ({} of []) geschreven is
+constexpr uint8_t TOKEN_EMPTY = 4;
+
+// Eén token op de tape (16 bytes). De kleur is al opgelost, inclusief de
+// key/value regels, dus een renderer hoeft geen paden meer bij te houden.
+struct TapeToken {
+    TokenKind kind;
+    uint8_t flags;
+    ColorSlot slot;
+    uint32_t depth;
+    uint32_t offset;  // In de input of (TOKEN_ARENA) in de arena
+    uint32_t length;
+};
+
+// Document als vlakke lijst tokens, één keer opgebouwd door de gewone
+// traversal en daarna naar elk formaat te renderen zonder opnieuw te parsen.
+// De slots horen bij de Style waarmee de tape is gemaakt; render de tape met
+// printers voor dezelfde Style.
+class TokenTape {
+private:
+    simdjson::padded_string input;  // Eigen kopie van de JSON input (leeg bij Python objecten)
+    std::string arena;              // Gedecodeerde strings en overige tekst
+    std::vector<TapeToken> tokens_;
+    size_t slot_count = 0;
+
+    friend class TapeEmitter;
+
+    static uint32_t checkedSize(size_t size) {
+        if (size > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Input too large for token tape");
+        }
+        return static_cast<uint32_t>(size);
+    }
+
+    void push(TokenKind kind, ColorSlot slot, uint32_t depth, std::string_view text, uint8_t flags) {
+        TapeToken token{kind, flags, slot, depth, 0, checkedSize(text.size())};
+        const char* begin = input.data();
+        if (!text.empty() && begin && text.data() >= begin && text.data() + text.size() <= begin + input.size()) {
+            token.offset = static_cast<uint32_t>(text.data() - begin);
+        } else if (!text.empty()) {
+            token.flags |= TOKEN_ARENA;
+            token.offset = checkedSize(arena.size());
+            arena.append(text.data(), text.size());
+            checkedSize(arena.size());
+        }
+        tokens_.push_back(token);
+    }
+
+public:
+    TokenTape() = default;
+    TokenTape(TokenTape&&) = default;
+    TokenTape& operator=(TokenTape&&) = default;
+
+    // Neem een document op: fn(emitter, compiled) draait de traversal met de
+    // TapeEmitter (zie fromJson en tapeFromPython)
+    template<typename Fn>
+    void record(const Style& style, Fn&& fn);
+
+    // Parse json_str één keer en neem het document op
+    static TokenTape fromJson(std::string_view json_str, const Style& style);
+
+    const std::vector<TapeToken>& tokens() const { return tokens_; }
+    size_t slotCount() const { return slot_count; }
+
+    std::string_view text(const TapeToken& token) const {
+        const char* base = (token.flags & TOKEN_ARENA) ? arena.data() : input.data();
+        return std::string_view(base + token.offset, token.length);
+    }
+};
+
+// Emitter die de tokens van de traversal op een tape zet in plaats van bytes
+// te schrijven. Key of string volgt uit de quote fragmenten eromheen.
+class TapeEmitter {
+private:
+    TokenTape& tape;
+    uint32_t depth = 0;
+    TokenKind quoted = TokenKind::Null;  // Key of String binnen quotes
+    bool in_quotes = false;
+
+    void push(TokenKind kind, ColorSlot slot, std::string_view text = {}, uint8_t flags = 0) {
+        tape.push(kind, slot, depth, text, flags);
+    }
+
+    // Kind van een scalar buiten quotes, afgeleid van de tekst
+    static TokenKind scalarKind(std::string_view text) {
+        if (text == "true" || text == "false" || text == "True" || text == "False") return TokenKind::Boolean;
+        if (text == "null") return TokenKind::Null;
+        return TokenKind::Number;
+    }
+
+public:
+    explicit TapeEmitter(TokenTape& t) : tape(t) {}
+
+    void increaseIndent() { depth++; }
+    void decreaseIndent() { depth--; }
+
+    template<typename P>
+    void fragment(Fragment id) {
+        switch (id) {
+            case Fragment::OpenBrace:    push(TokenKind::ObjectStart, slotOf(ElementType::Brace)); break;
+            case Fragment::CloseBrace:   push(TokenKind::ObjectEnd, slotOf(ElementType::Brace)); break;
+            case Fragment::OpenBracket:  push(TokenKind::ArrayStart, slotOf(ElementType::Bracket)); break;
+            case Fragment::CloseBracket: push(TokenKind::ArrayEnd, slotOf(ElementType::Bracket)); break;
+            case Fragment::EmptyBrace:
+                push(TokenKind::ObjectStart, slotOf(ElementType::Brace), {}, TOKEN_EMPTY);
+                push(TokenKind::ObjectEnd, slotOf(ElementType::Brace), {}, TOKEN_EMPTY);
+                break;
+            case Fragment::EmptyBracket:
+                push(TokenKind::ArrayStart, slotOf(ElementType::Bracket), {}, TOKEN_EMPTY);
+                push(TokenKind::ArrayEnd, slotOf(ElementType::Bracket), {}, TOKEN_EMPTY);
+                break;
+            case Fragment::KeyQuote:
+                in_quotes = !in_quotes;
+                quoted = TokenKind::Key;
+                break;
+            case Fragment::StringQuote:
+                in_quotes = !in_quotes;
+                quoted = TokenKind::String;
+                break;
+            case Fragment::Separator:
+            case Fragment::Colon:
+                break;  // Volgt uit de structuur
+        }
+    }
+
+    template<typename P>
+    void lineBreak() {}
+
+    template<typename P>
+    void token(ColorSlot slot, std::string_view text) {
+        push(in_quotes ? quoted : scalarKind(text), slot, text);
+    }
+
+    template<typename P>
+    void escapedToken(ColorSlot slot, std::string_view s) {
+        push(in_quotes ? quoted : TokenKind::String, slot, s, TOKEN_ESCAPE);
+    }
+
+    void finish() {}
+};
+
+template<typename Fn>
+void TokenTape::record(const Style& style, Fn&& fn) {
+    // Alleen voor de slots en de key/value regels; die zijn gelijk voor elk formaat
+    CompiledStyle compiled = CompiledStyle::ansi(style);
+    slot_count = compiled.slotCount();
+    TapeEmitter emitter(*this);
+    fn(emitter, compiled);
+}
+
+inline TokenTape TokenTape::fromJson(std::string_view json_str, const Style& style) {
+    TokenTape tape;
+    tape.input = simdjson::padded_string(json_str);
+    checkedSize(tape.input.size());
+    try {
+        ParserPool::Lease parser = ParserPool::acquire(tape.input.size());
+        simdjson::ondemand::document doc = parser->iterate(tape.input);
+        simdjson::ondemand::value val;
+        auto val_error = doc.get_value().get(val);
+        if (val_error) {
+            throw std::runtime_error("Failed to get document value");
+        }
+        tape.record(style, [&](TapeEmitter& emitter, const CompiledStyle& compiled) {
+            renderJsonValue(emitter, style, compiled, val);
+        });
+    } catch (const simdjson::simdjson_error& e) {
+        throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("JSON processing error: " + std::string(e.what()));
+    }
+    return tape;
+}
+
+// Speel een tape af naar een emitter; de output is gelijk aan die van de
+// traversal zelf
+template<typename Emitter>
+class TapeRenderer {
+private:
+    Emitter& out;
+    const TokenTape& tape;
+
+    static bool isStart(TokenKind kind) {
+        return kind == TokenKind::ObjectStart || kind == TokenKind::ArrayStart;
+    }
+
+    template<typename P>
+    void text(const TapeToken& t) {
+        if (t.flags & TOKEN_ESCAPE) {
+            out.template escapedToken<P>(t.slot, tape.text(t));
+        } else {
+            out.template token<P>(t.slot, tape.text(t));
+        }
+    }
+
+public:
+    TapeRenderer(Emitter& emitter, const TokenTape& t) : out(emitter), tape(t) {}
+
+    template<typename P>
+    void render() {
+        TokenKind prev = TokenKind::Key;  // Geen scheiding voor de root
+        for (const TapeToken& t : tape.tokens()) {
+            if (t.kind == TokenKind::ObjectEnd || t.kind == TokenKind::ArrayEnd) {
+                if (t.flags & TOKEN_EMPTY) {
+                    prev = t.kind;  // Al geschreven met de start
+                    continue;
+                }
+                out.decreaseIndent();
+                if (!isStart(prev)) out.template lineBreak<P>();
+                out.template fragment<P>(t.kind == TokenKind::ObjectEnd ? Fragment::CloseBrace : Fragment::CloseBracket);
+                prev = t.kind;
+                continue;
+            }
+
+            // Eerste element na een open: newline, daarna een separator; een
+            // value direct na zijn key heeft al een colon gekregen
+            if (isStart(prev)) {
+                out.template lineBreak<P>();
+            } else if (prev != TokenKind::Key) {
+                out.template fragment<P>(Fragment::Separator);
+            }
+
+            if (t.flags & TOKEN_EMPTY) {
+                out.template fragment<P>(t.kind == TokenKind::ObjectStart ? Fragment::EmptyBrace : Fragment::EmptyBracket);
+                prev = t.kind == TokenKind::ObjectStart ? TokenKind::ObjectEnd : TokenKind::ArrayEnd;
+                continue;
+            }
+
+            switch (t.kind) {
+                case TokenKind::ObjectStart:
+                    out.template fragment<P>(Fragment::OpenBrace);
+                    out.increaseIndent();
+                    break;
+                case TokenKind::ArrayStart:
+                    out.template fragment<P>(Fragment::OpenBracket);
+                    out.increaseIndent();
+                    break;
+                case TokenKind::Key:
+                    out.template fragment<P>(Fragment::KeyQuote);
+                    text<P>(t);
+                    out.template fragment<P>(Fragment::KeyQuote);
+                    out.template fragment<P>(Fragment::Colon);
+                    break;
+                case TokenKind::String:
+                    out.template fragment<P>(Fragment::StringQuote);
+                    text<P>(t);
+                    out.template fragment<P>(Fragment::StringQuote);
+                    break;
+                default:
+                    text<P>(t);
+                    break;
+            }
+            prev = t.kind;
+        }
+    }
+};
+
+// Render een tape met emitter out; de tape moet met dezelfde Style gemaakt zijn
+template<typename Emitter>
+void renderTape(Emitter& out, const Style& style, const CompiledStyle& compiled, const TokenTape& tape) {
+    if (tape.slotCount() != compiled.slotCount()) {
+        throw std::runtime_error("Token tape was recorded with a different style");
+    }
+    TapeRenderer<Emitter> renderer(out, tape);
+    withStylePolicy(style, compiled, [&](auto policy) {
+        renderer.template render<decltype(policy)>();
+    });
+    out.finish();
+}
+
+} // namespace colored_json
@@ -1,5 +1,9 @@
 #!/usr/bin/env python3
 """Unit tests voor colored_json module"""
+import enum
+import json
+import re
+
 import pytest
 import colored_json
 
@@ -83,6 +87,35 @@ def test_string_escaping():
     assert "\\\\" in result or "\\" in result
 
 
+def test_long_string_escaping():
+    """Test escaping rond de 16/32 byte blokgrenzen van de SIMD escaper"""
+    style = colored_json.Style()
+    style.compact = True
+    
+    for length in (15, 16, 17, 31, 32, 33, 63, 64, 65, 200):
+        for special in ('"', "\\", "\n", "\x01", "\x1f", "é"):
+            for pos in (0, length // 2, length - 1):
+                text = "x" * pos + special + "y" * (length - pos - 1)
+                data = {"msg": text}
+                result = colored_json.format(data, style)
+                plain = re.sub(r"\x1b\[[0-9;]*m", "", result)
+                assert plain == json.dumps(data, ensure_ascii=False, separators=(",", ":"))
+
+
+def test_verbatim_strings():
+    """Test dat verbatim_strings de ge-escapete input ongewijzigd kopieert"""
+    json_str = '{"k\\u00e9y": "caf\\u00e9 \\/ \\"q\\"", "n": 1}'
+    style = colored_json.Style()
+    style.compact = True
+    
+    decoded = re.sub(r"\x1b\[[0-9;]*m", "", colored_json.format_from_json(json_str, style))
+    assert decoded == '{"kéy":"café / \\"q\\"","n":1}'
+    
+    style.verbatim_strings = True
+    verbatim = re.sub(r"\x1b\[[0-9;]*m", "", colored_json.format_from_json(json_str, style))
+    assert verbatim == '{"k\\u00e9y":"caf\\u00e9 \\/ \\"q\\"","n":1}'
+
+
 def test_dict_formatting():
     """Test dict formatting"""
     data = {"name": "Alice", "age": 30}
@@ -183,6 +216,310 @@ def test_custom_colors():
     assert len(result) > 0
 
 
+def test_path_value_colors():
+    """Test value kleuren op genest pad, ook binnen arrays"""
+    style = colored_json.Style()
+    style.color_mode = colored_json.ColorMode.TRUECOLOR
+    style.set_value_color("users[1].name", colored_json.Color(1, 2, 3))
+    style.set_key_color("meta.id", colored_json.Color(4, 5, 6))
+    
+    data = {"users": [{"name": "Bob"}, {"name": "Eve"}], "meta": {"id": 7}}
+    for result in (colored_json.format(data, style),
+                   colored_json.format_from_json(json.dumps(data), style)):
+        assert "\x1b[38;2;1;2;3mEve" in result
+        assert "\x1b[38;2;1;2;3mBob" not in result
+        assert "\x1b[38;2;4;5;6mid" in result
+
+
+def test_path_wildcards():
+    """Test wildcards in paden; het meest specifieke pad wint"""
+    style = colored_json.Style()
+    style.color_mode = colored_json.ColorMode.TRUECOLOR
+    style.set_value_color("users[*].email", colored_json.Color(1, 2, 3))
+    style.set_value_color("users[1].email", colored_json.Color(4, 5, 6))
+    style.set_value_color("*.id", colored_json.Color(7, 8, 9))
+    
+    data = {"users": [{"email": "a@x"}, {"email": "b@x"}], "meta": {"id": 5}, "id": 6}
+    for result in (colored_json.format(data, style),
+                   colored_json.format_from_json(json.dumps(data), style)):
+        assert "\x1b[38;2;1;2;3ma@x" in result
+        assert "\x1b[38;2;4;5;6mb@x" in result
+        assert "\x1b[38;2;7;8;9m5" in result
+        assert "\x1b[38;2;7;8;9m6" not in result
+
+
+def test_path_rules_match_literal_keys():
+    """Test dat een regel met een punt ook een key met die letterlijke naam matcht"""
+    style = colored_json.Style()
+    style.color_mode = colored_json.ColorMode.TRUECOLOR
+    style.set_value_color("a.b", colored_json.Color(1, 2, 3))
+    style.set_key_color("x.y", colored_json.Color(4, 5, 6))
+    
+    data = {"a.b": "lit", "a": {"b": "nested"}, "c": {"x.y": 1}, "x": {"y": 2}}
+    for result in (colored_json.format(data, style),
+                   colored_json.format_from_json(json.dumps(data), style)):
+        assert "\x1b[38;2;1;2;3mlit" in result
+        assert "\x1b[38;2;1;2;3mnested" in result
+        assert result.count("\x1b[38;2;4;5;6m") == 2
+
+
+def test_color_runs():
+    """Test dat aangrenzende tokens met dezelfde kleur geen extra escapes krijgen"""
+    style = colored_json.Style.get_preset("default")
+    style.color_mode = colored_json.ColorMode.ANSI16
+    style.compact = True
+    
+    result = colored_json.format_from_json('{"a": [1, 2], "b": "x"}', style)
+    assert result.count("\x1b[0m") == 1
+    assert result.endswith("\x1b[0m")
+    assert re.sub(r"\x1b\[[0-9;]*m", "", result) == '{"a":[1,2],"b":"x"}'
+    
+    style.color_mode = colored_json.ColorMode.DISABLED
+    assert "\x1b" not in colored_json.format({"a": [1, 2]}, style)
+
+
+def test_deep_indent():
+    """Test indentatie dieper dan de vooraf gerenderde indent slab"""
+    style = colored_json.Style()
+    style.color_mode = colored_json.ColorMode.DISABLED
+    style.indent_size = 3
+    
+    data = 7
+    for _ in range(40):
+        data = {"a": [1, data]}
+    expected = json.dumps(data, indent=3)
+    assert colored_json.format(data, style) == expected
+    assert colored_json.format_from_json(json.dumps(data), style) == expected
+
+
+def test_plain_mode():
+    """Test dat DISABLED pure tekst geeft (minify en platte pretty print)"""
+    style = colored_json.Style()
+    style.color_mode = colored_json.ColorMode.DISABLED
+    json_str = '{ "a" : [1, 2.50, "x y", []], "b": {}, "c": null }'
+    
+    style.compact = True
+    assert colored_json.format_from_json(json_str, style) == '{"a":[1,2.50,"x y",[]],"b":{},"c":null}'
+    
+    style.compact = False
+    expected = '{\n  "a": [\n    1,\n    2.50,\n    "x y",\n    []\n  ],\n  "b": {},\n  "c": null\n}'
+    assert colored_json.format_from_json(json_str, style) == expected
+    
+    # Getallen buiten 64 bits zijn geldige JSON en blijven ongewijzigd
+    big = '{"id": 123456789012345678901234567890, "n": [-99999999999999999999999]}'
+    assert colored_json.format_from_json(big, style) == '{\n  "id": 123456789012345678901234567890,\n  "n": [\n    -99999999999999999999999\n  ]\n}'
+    style.compact = True
+    assert colored_json.format_from_json(big, style) == '{"id":123456789012345678901234567890,"n":[-99999999999999999999999]}'
+
+
+def test_html_css_classes():
+    """Test dat css_classes één stylesheet en korte class spans geeft"""
+    style = colored_json.Style()
+    style.set_value_color("user.name", colored_json.Color(255, 0, 0))
+    data = {"user": {"name": "Ann", "age": 3}}
+    inline = colored_json.to_html(data, style)
+    
+    style.css_classes = True
+    html = colored_json.to_html(data, style)
+    assert html.count("<style>") == 1
+    assert '<span class="k">user</span>' in html
+    assert ".v0 { color: rgb(255,0,0) }" in html
+    assert '<span class="v0">Ann</span>' in html
+    assert '<span style="' not in html
+    assert len(html) < len(inline)
+    assert colored_json.to_html_from_json(json.dumps(data), style) == html
+    
+    md = colored_json.to_markdown_html(data, style)
+    assert md.count("<style>") == 1 and '<span class="k">' in md
+
+
+def test_html_escaping():
+    """Test JSON plus HTML escaping en samengevoegde spans"""
+    style = colored_json.Style()
+    style.css_classes = True
+    style.compact = True
+    html = colored_json.to_html({"a": 'x<"y">&\'\n'}, style)
+    assert '<span class="s">x&lt;\\&quot;y\\&quot;&gt;&amp;&#39;\\n</span>' in html
+    assert '<span class="br">&quot;:&quot;</span>' in html
+    assert html.count("<span") == html.count("</span>")
+
+
+def test_render_formats():
+    """Test meerdere formaten uit één parse"""
+    style = colored_json.Style.get_preset("monokai")
+    style.set_key_color("name", colored_json.Color(255, 0, 0))
+    style.set_value_color("tags[1]", colored_json.Color(0, 255, 0))
+    data = {"name": "Ann \"A\"", "tags": ["x", "y"], "empty": {}, "none": None, "ok": True}
+    json_str = json.dumps(data)
+    formats = ["ansi", "html", "markdown", "markdown_html"]
+
+    for obj in [data, json_str]:
+        out = colored_json.render_formats(obj, style, formats, title="T")
+        assert list(out) == formats
+        assert out["ansi"] == colored_json.format(obj, style)
+        assert out["html"] == colored_json.to_html(obj, style, title="T")
+        assert out["markdown"] == colored_json.to_markdown(obj, style, title="T")
+        assert out["markdown_html"] == colored_json.to_markdown_html(obj, style, title="T")
+
+    with pytest.raises(RuntimeError):
+        colored_json.render_formats(data, style, ["pdf"])
+
+
+def test_parallel_render():
+    """Test dat een grote root array/object parallel dezelfde output geeft"""
+    records = [{"id": i, "name": f"user{i}", "tags": ["a", "b\"c", str(i)], "ok": i % 2 == 0}
+               for i in range(20000)]
+    style = colored_json.Style()
+    style.set_value_color("tags[1]", colored_json.Color(0, 255, 0))
+    quote = colored_json.Color(255, 0, 0)
+    quote.underline = True
+    style.key_quote_color = quote
+
+    for doc in [records, {f"k{i}": r for i, r in enumerate(records)}]:
+        json_str = json.dumps(doc)
+        assert len(json_str) > 1024 * 1024
+        style.threads = 1
+        sequential = colored_json.format_from_json(json_str, style)
+        html = colored_json.to_html_from_json(json_str, style)
+        style.threads = 4
+        assert colored_json.format_from_json(json_str, style) == sequential
+        assert colored_json.to_html_from_json(json_str, style) == html
+
+
+def test_python_object_snapshot():
+    """Test Python objecten via de snapshot (subclasses, grote objecten, cycli)"""
+    class Label(str):
+        def __str__(self):
+            return "other"
+
+    class Level(enum.IntEnum):
+        HIGH = 2
+
+    style = colored_json.Style()
+    style.color_mode = colored_json.ColorMode.DISABLED
+    data = {"label": Label("raw"), "level": Level.HIGH, 3: 1.5, "big": 2**70, "flag": True}
+    result = colored_json.format(data, style)
+    assert '"label": "raw"' in result
+    assert f'"level": {Level.HIGH}' in result
+    assert '"3": 1.5' in result
+    assert f'"big": {2**70}' in result
+    assert '"flag": True' in result
+
+    records = [{"id": i, "name": f"user{i}", "tags": ["a", str(i)], "ok": i % 2 == 0} for i in range(40000)]
+    style = colored_json.Style()
+    style.set_value_color("tags[1]", colored_json.Color(0, 255, 0))
+    style.threads = 1
+    sequential = colored_json.format(records, style)
+    style.threads = 4
+    assert colored_json.format(records, style) == sequential
+
+    cycle = []
+    cycle.append(cycle)
+    with pytest.raises(RecursionError):
+        colored_json.format(cycle)
+
+
+def test_json_buffer_input():
+    """Test bytes, bytearray en memoryview input voor de *_from_json functies"""
+    style = colored_json.Style.get_preset("dracula")
+    json_str = json.dumps({"name": "Zoë", "tags": ["a", "b"], "n": 1.5})
+    raw = json_str.encode()
+    for data in [raw, bytearray(raw), memoryview(raw), memoryview(b"xx" + raw)[2:]]:
+        assert colored_json.format_from_json(data, style) == colored_json.format_from_json(json_str, style)
+        assert colored_json.to_html_from_json(data, style) == colored_json.to_html_from_json(json_str, style)
+        assert colored_json.to_markdown_from_json(data, style) == colored_json.to_markdown_from_json(json_str, style)
+        assert colored_json.to_markdown_html_from_json(data, style) == \
+            colored_json.to_markdown_html_from_json(json_str, style)
+
+    # Wisselende lengtes: de input eindigt op steeds een andere plek in de pagina
+    for size in range(1, 200):
+        doc = json.dumps({"k": "x" * size})
+        assert colored_json.format_from_json(doc.encode(), style) == colored_json.format_from_json(doc, style)
+
+    with pytest.raises(TypeError):
+        colored_json.format_from_json(123, style)
+    with pytest.raises(RuntimeError):
+        colored_json.format_from_json(b'{"a": ', style)
+
+
+def test_bytes_output():
+    """Test as_bytes en into voor het resultaat als bytes of in een buffer"""
+    style = colored_json.Style.get_preset("dracula")
+    data = {"name": "Zoë", "tags": ["a", "b"], "n": 1.5}
+    json_str = json.dumps(data)
+
+    expected = colored_json.format(data, style).encode()
+    assert colored_json.format(data, style, as_bytes=True) == expected
+    assert colored_json.format_from_json(json_str, style, as_bytes=True) == \
+        colored_json.format_from_json(json_str, style).encode()
+    assert colored_json.to_html_from_json(json_str, style, as_bytes=True) == \
+        colored_json.to_html_from_json(json_str, style).encode()
+    assert colored_json.to_markdown(data, style, as_bytes=True) == colored_json.to_markdown(data, style).encode()
+
+    # Grote buffer: aantal bytes terug, de rest blijft staan
+    buf = bytearray(b"\xff" * (len(expected) + 10))
+    assert colored_json.format(data, style, into=buf) == len(expected)
+    assert bytes(buf[:len(expected)]) == expected
+    assert buf[len(expected):] == b"\xff" * 10
+
+    # Te kleine bytearray groeit mee
+    small = bytearray(4)
+    assert colored_json.format(data, style, into=small) == len(expected)
+    assert bytes(small) == expected
+
+    html = colored_json.to_html_from_json(json_str.encode(), style).encode()
+    view_buf = bytearray(len(html) + 1)
+    assert colored_json.to_html_from_json(json_str, style, into=memoryview(view_buf)) == len(html)
+    assert bytes(view_buf[:len(html)]) == html
+
+    # Een memoryview kan niet groeien
+    with pytest.raises(ValueError):
+        colored_json.format(data, style, into=memoryview(bytearray(4)))
+    with pytest.raises((TypeError, BufferError)):
+        colored_json.format(data, style, into=b"readonly")
+
+
+
+def test_concurrent_json_threads():
+    """Test gelijktijdige aanroepen zonder GIL vanuit meerdere Python threads"""
+    from concurrent.futures import ThreadPoolExecutor
+
+    style = colored_json.Style.get_preset("solarized")
+    docs = [json.dumps({"id": i, "data": ["x" * (i * 97 % 5000)], "nested": {"ok": True}}) for i in range(64)]
+    docs.append(json.dumps([{"k": "v" * 50, "n": i} for i in range(30000)]))  # Parallel pad
+    expected = [colored_json.format_from_json(d, style) for d in docs]
+    expected_html = [colored_json.to_html_from_json(d, style) for d in docs]
+
+    def render(i):
+        return colored_json.format_from_json(docs[i], style), colored_json.to_html_from_json(docs[i], style)
+
+    with ThreadPoolExecutor(max_workers=8) as pool:
+        for _ in range(3):
+            results = list(pool.map(render, range(len(docs))))
+            assert [r[0] for r in results] == expected
+            assert [r[1] for r in results] == expected_html
+
+def test_format_many():
+    """Test batch rendering van meerdere JSON strings"""
+    style = colored_json.Style.get_preset("monokai")
+    style.set_value_color("tags[0]", colored_json.Color(0, 255, 0))
+    docs = [json.dumps({"id": i, "tags": [f"t{i}", "x<y"], "ok": i % 3 == 0}) for i in range(200)]
+    docs += ["[]", '{"a": "\\u00e9"}']
+    inputs = [d.encode() if i % 2 else d for i, d in enumerate(docs)]
+
+    for threads in [1, 4]:
+        assert colored_json.format_many(inputs, style, threads=threads) == \
+            [colored_json.format_from_json(d, style) for d in docs]
+        assert colored_json.to_html_many(inputs, style, threads=threads, title="T") == \
+            [colored_json.to_html_from_json(d, style, title="T") for d in docs]
+    assert colored_json.format_many([], style) == []
+
+    with pytest.raises(RuntimeError, match="Input 1"):
+        colored_json.format_many(['{"a": 1}', '{"a": '], style)
+    with pytest.raises(TypeError):
+        colored_json.format_many([{"a": 1}], style)
+
+
 def test_color_modes():
     """Test verschillende color modes"""
     data = {"test": "value"}
@@ -232,6 +569,196 @@ def test_printer_class():
     assert "test" in result
 
 
+def test_printer_reuse():
+    """Test hergebruik van een printer over veel documenten"""
+    style = colored_json.Style.get_preset("dracula")
+    printer = colored_json.Printer(style)
+    html_printer = colored_json.HtmlPrinter(style, max_capacity=4096)
+    md_printer = colored_json.MarkdownPrinter(style)
+    assert printer.max_capacity == 0
+    assert html_printer.max_capacity == 4096
+
+    docs = [json.dumps({"id": i, "tags": ["x" * i], "ok": i % 2 == 0}) for i in range(50)]
+    docs.insert(25, json.dumps([{"k": "v" * 100}] * 1000))  # Groter dan max_capacity
+    for doc in docs:
+        assert printer.print(doc) == colored_json.format_from_json(doc, style)
+        assert html_printer.print(doc) == colored_json.to_html_from_json(doc, style)
+        assert md_printer.print_html(doc) == colored_json.to_markdown_html_from_json(doc, style)
+
+    # Een gewijzigde Style wordt bij de volgende aanroep opnieuw gecompileerd
+    style.key_color = colored_json.Color(1, 2, 3)
+    assert printer.print(docs[0]) == colored_json.format_from_json(docs[0], style)
+    printer.max_capacity = 1
+    assert printer.print({"a": 1}) == colored_json.format({"a": 1}, style)
+
+
+def test_dump_streaming(tmp_path):
+    """Test dump() en Printer.print_to() naar een file object en een file descriptor"""
+    import io
+    import os
+
+    style = colored_json.Style.get_preset("monokai")
+    data = {"name": "Zoë €", "items": [{"k": "v" * 100, "n": i} for i in range(2000)]}
+    json_str = json.dumps(data, ensure_ascii=False)
+    expected = colored_json.format_from_json(json_str, style)
+
+    # Kleine blokken: UTF-8 sequenties vallen over de blokgrens
+    text = io.StringIO()
+    colored_json.dump(json_str, text, style, chunk_size=7)
+    assert text.getvalue() == expected
+
+    binary = io.BytesIO()
+    colored_json.dump(json_str.encode(), binary, style)
+    assert binary.getvalue() == expected.encode()
+
+    binary = io.BytesIO()
+    colored_json.dump(data, binary, style)
+    assert binary.getvalue() == colored_json.format(data, style).encode()
+
+    path = tmp_path / "out.txt"
+    fd = os.open(path, os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+    try:
+        printer = colored_json.Printer(style)
+        printer.print_to(json_str, fd, chunk_size=1024)
+        printer.print_to(json_str, fd)
+    finally:
+        os.close(fd)
+    assert path.read_bytes() == expected.encode() * 2
+
+    # Compacte output zonder kleur gaat met een sink via de emitter
+    plain = colored_json.Style()
+    plain.color_mode = colored_json.ColorMode.DISABLED
+    plain.compact = True
+    binary = io.BytesIO()
+    colored_json.dump(json_str, binary, plain, chunk_size=64)
+    assert binary.getvalue() == colored_json.format_from_json(json_str, plain).encode()
+
+    class FailingWriter:
+        def write(self, chunk):
+            raise OSError("disk full")
+
+    with pytest.raises(OSError, match="disk full"):
+        colored_json.dump(json_str, FailingWriter(), style)
+    with pytest.raises(ValueError):
+        colored_json.dump(json_str, io.BytesIO(), style, chunk_size=0)
+
+    # Een printer die eerst een groot document in zijn buffer rendert blijft
+    # daarna toch in blokken van chunk_size schrijven
+    class SizeWriter:
+        def __init__(self):
+            self.sizes = []
+
+        def write(self, chunk):
+            self.sizes.append(len(chunk))
+
+    serial = colored_json.Style.get_preset("monokai")
+    serial.threads = 1
+    printer = colored_json.Printer(serial)
+    printer.print(json_str)
+    writer = SizeWriter()
+    printer.print_to(json_str, writer, chunk_size=4096)
+    assert sum(writer.sizes) == len(expected.encode())
+    assert len(writer.sizes) > 1
+    assert max(writer.sizes) <= 4096
+
+
+def test_format_async():
+    """Test format_async en to_html_async vanuit een event loop"""
+    import asyncio
+
+    style = colored_json.Style.get_preset("dracula")
+    docs = [json.dumps({"id": i, "name": "Zoë" * (i % 7), "items": list(range(i % 20))}) for i in range(40)]
+    docs.append(json.dumps([{"k": "v" * 50, "n": i} for i in range(30000)]))  # Parallel pad
+    data = {"name": "Alice", "tags": ["a", "b"], "n": 1.5}
+
+    async def run():
+        results = await asyncio.gather(*[colored_json.format_async(d, style) for d in docs])
+        assert results == [colored_json.format_from_json(d, style) for d in docs]
+
+        assert await colored_json.format_async(data, style) == colored_json.format(data, style)
+        assert await colored_json.format_async(docs[0].encode(), style, as_bytes=True) == \
+            colored_json.format_from_json(docs[0], style).encode()
+        assert await colored_json.to_html_async(docs[1], style, title="Async") == \
+            colored_json.to_html_from_json(docs[1], style, title="Async")
+        assert await colored_json.to_html_async(data, style) == colored_json.to_html(data, style)
+
+        with pytest.raises(RuntimeError):
+            await colored_json.format_async('{"a": ', style)
+
+        # De Style wordt bij de aanroep gekopieerd
+        expected = colored_json.format_from_json(docs[2], style)
+        future = colored_json.format_async(docs[2], style)
+        style.key_color = colored_json.Color(1, 2, 3)
+        assert await future == expected
+
+        # Een geannuleerde future wordt overgeslagen
+        colored_json.format_async(docs[-1], style).cancel()
+        await asyncio.sleep(0.1)
+
+    asyncio.run(run())
+
+    # Zonder lopende event loop
+    with pytest.raises(RuntimeError):
+        colored_json.format_async(docs[0], style)
+
+
+def test_style_snapshot_threads():
+    """Test dat een Style wijzigen tijdens renders op andere threads veilig is"""
+    import threading
+    from concurrent.futures import ThreadPoolExecutor
+
+    style = colored_json.Style.get_preset("monokai")
+    doc = json.dumps({"name": "Alice", "items": [{"name": "x" * 20, "n": i} for i in range(500)]})
+    red, blue = colored_json.Color(255, 0, 0), colored_json.Color(0, 0, 255)
+    style.set_key_color("name", red)
+    expected_red = colored_json.format_from_json(doc, style)
+    style.set_key_color("name", blue)
+    expected_blue = colored_json.format_from_json(doc, style)
+    assert expected_red != expected_blue
+
+    stop = threading.Event()
+
+    def mutate():
+        while not stop.is_set():
+            style.set_key_color("name", red)
+            style.set_key_color("name", blue)
+
+    def render(_):
+        return colored_json.format_from_json(doc, style)
+
+    writer = threading.Thread(target=mutate)
+    writer.start()
+    try:
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            results = list(pool.map(render, range(200)))
+    finally:
+        stop.set()
+        writer.join()
+    assert all(r in (expected_red, expected_blue) for r in results)
+
+    # Toewijzen en in-place wijzigen van een kleur blijven werken, ook via
+    # een eerder opgehaalde kleur; beide gaan door de lock van de Style
+    style.key_color = colored_json.Color(1, 2, 3)
+    style.key_color.bold = True
+    assert style.key_color.bold
+    assert style.key_color.r == 1
+    key_color = style.key_color
+    key_color.r = 9
+    assert style.key_color.r == 9
+    style.string_color = style.key_color
+    style.set_value_color("x", key_color)
+    key_color.g = 7
+    assert style.string_color.r == 9
+    assert style.string_color.g == 2
+    assert style.value_colors["x"].bold
+    assert isinstance(style.value_colors["x"], colored_json.Color)
+
+    # Een in-place wijziging maakt de snapshot ongeldig
+    before = colored_json.format_from_json(doc, style)
+    style.number_color.underline = True
+    assert colored_json.format_from_json(doc, style) != before
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
 
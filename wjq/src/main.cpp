@@ -1,13 +1,22 @@
+#include <atomic>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "compiled_style.hpp"
+#include "emitters.hpp"
 #include "json_parser.hpp"
-#include "printer.hpp"
+#include "output_buffer.hpp"
+#include "plain_format.hpp"
+#include "render_engine.hpp"
 #include "style.hpp"
+#include "thread_pool.hpp"
 
 // Windows-specific headers voor console kleuren
 #ifdef _WIN32
@@ -35,7 +44,9 @@ struct CommandLineOptions {
   std::string theme = "default";
   std::string color_mode_str = "auto";
   bool compact = false;
+  bool verbatim = false;
   int indent_size = 2;
+  int threads = 1;
   bool show_help = false;
   bool show_version = false;
 };
@@ -50,6 +61,10 @@ void printUsage(const char *programName) {
   std::cerr << "  -c, --compact          Compacte output (geen extra "
                "spaties/nieuwe regels)\n";
   std::cerr << "  -i, --indent N         Indentatiegrootte (standaard: 2)\n";
+  std::cerr << "      --verbatim         Strings ongewijzigd (ge-escaped) uit de "
+               "input kopiëren\n";
+  std::cerr << "      --threads N        Documenten (JSONL) met kleur op N threads "
+               "renderen (0 = alle cores, standaard: 1)\n";
   std::cerr << "  -h, --help             Toon deze help\n";
   std::cerr << "  -v, --version          Toon versie\n\n";
   std::cerr << "Filters:\n";
@@ -59,6 +74,7 @@ void printUsage(const char *programName) {
   std::cerr << "  " << programName << " data.json\n";
   std::cerr << "  " << programName << " -t monokai data.json\n";
   std::cerr << "  " << programName << " -c -i 4 data.json\n";
+  std::cerr << "  " << programName << " --threads 8 logs.jsonl\n";
   std::cerr << "  cat data.json | " << programName
             << " -t neon --color-mode 256\n";
 }
@@ -92,6 +108,17 @@ CommandLineOptions parseArguments(int argc, char *argv[]) {
       }
     } else if (arg == "-c" || arg == "--compact") {
       opts.compact = true;
+    } else if (arg == "--verbatim") {
+      opts.verbatim = true;
+    } else if (arg == "--threads") {
+      if (i + 1 < argc) {
+        opts.threads = std::stoi(argv[++i]);
+        if (opts.threads < 0) {
+          throw std::runtime_error("Threads moet 0 of groter zijn");
+        }
+      } else {
+        throw std::runtime_error("N ontbreekt na " + arg);
+      }
     } else if (arg == "-i" || arg == "--indent") {
       if (i + 1 < argc) {
         opts.indent_size = std::stoi(argv[++i]);
@@ -158,6 +185,211 @@ colored_json::ColorMode parseColorMode(const std::string &mode) {
   throw std::runtime_error("Ongeldige kleurmodus: " + mode);
 }
 
+// Eén document met kleur (of, bij ColorMode::Disabled, als platte tekst)
+// via de gedeelde traversal naar out
+void renderValue(colored_json::OutputBuffer &out,
+                 const colored_json::Style &style,
+                 const colored_json::CompiledStyle &compiled,
+                 simdjson::ondemand::value val) {
+  colored_json::AnsiEmitter emitter(out, compiled, style.indent_size);
+  colored_json::renderJsonValue(emitter, style, compiled, val);
+}
+
+// --color-mode disabled: elk document alleen opnieuw formatteren (simdjson
+// minify of de platte pretty printer), zonder token traversal. De
+// documentgrenzen komen net als met kleur uit iterate_many; een document met
+// escapes of getallen buiten 64 bits gaat via de emitter.
+void printPlain(simdjson::padded_string &json, const colored_json::Style &style,
+                const colored_json::CompiledStyle &compiled,
+                colored_json::OutputBuffer &out) {
+  colored_json::JsonParser parser;
+  auto stream = parser.parseMany(json);
+  simdjson::dom::parser validator;
+
+  bool first_doc = true;
+  for (auto it = stream.begin(); it != stream.end(); ++it) {
+    auto doc_error = (*it).error();
+    if (doc_error) {
+      throw simdjson::simdjson_error(doc_error);
+    }
+    if (!first_doc)
+      out.push_back('\n');
+    first_doc = false;
+
+    // Bij een onvolledig document loopt source() door tot in de padding
+    std::string_view source = it.source();
+    size_t available = static_cast<size_t>(json.data() + json.size() - source.data());
+    if (source.size() > available)
+      source = source.substr(0, available);
+    size_t start = source.find_first_not_of(" \n\r\t");
+    if (start == std::string_view::npos ||
+        (source[start] != '{' && source[start] != '[')) {
+      throw std::runtime_error("Kan root value niet ophalen");
+    }
+
+    if (!colored_json::plainFormatApplies(source, style.verbatim_strings) ||
+        !colored_json::validateJson(validator, source)) {
+      // Strings met escapes worden net als in de kleurmodus herschreven
+      auto doc = (*it).value();
+      simdjson::ondemand::value val;
+      auto val_error = doc.get_value().get(val);
+      if (val_error) {
+        throw std::runtime_error("Kan root value niet ophalen");
+      }
+      renderValue(out, style, compiled, val);
+    } else if (style.compact) {
+      colored_json::appendMinifiedJson(out, source);
+    } else {
+      colored_json::appendPrettyJson(out, source,
+                                     static_cast<size_t>(style.indent_size));
+    }
+  }
+}
+
+// Alle documenten (JSONL via iterate_many) met kleur. De eerste skip_docs
+// documenten zijn al geschreven (terugval vanuit --threads) en worden
+// overgeslagen.
+void printColored(simdjson::padded_string &json,
+                  const colored_json::Style &style,
+                  const colored_json::CompiledStyle &compiled,
+                  colored_json::OutputBuffer &out, size_t skip_docs = 0) {
+  colored_json::JsonParser parser;
+  auto stream = parser.parseMany(json);
+
+  size_t doc_index = 0;
+  for (auto doc_res : stream) {
+    if (doc_index++ < skip_docs)
+      continue;
+    if (doc_index > 1)
+      out.push_back('\n');
+
+    auto doc = doc_res.value();
+    simdjson::ondemand::value val;
+    auto val_error = doc.get_value().get(val);
+    if (val_error) {
+      throw std::runtime_error("Kan root value niet ophalen");
+    }
+    renderValue(out, style, compiled, val);
+  }
+}
+
+// Documenten per render taak in --threads mode; kleine documenten worden
+// gebundeld zodat de overhead per taak verwaarloosbaar blijft
+constexpr size_t BATCH_BYTES = 256 * 1024;
+
+// Aaneengesloten reeks documenten uit de input voor één render taak
+struct RenderBatch {
+  std::vector<std::string_view> docs;
+  size_t first_doc = 0; // Index van het eerste document in de input
+  colored_json::OutputBuffer output;
+  std::exception_ptr error; // Output tot en met het mislukte document blijft staan
+  std::atomic<bool> done{false};
+};
+
+// Render een batch met een parser van de eigen thread (ParserPool). De
+// documenten worden niet gekopieerd: ze staan in de gepadde input, die tot
+// buffer_end leesbaar is.
+void renderBatch(RenderBatch &batch, const char *buffer_end,
+                 const colored_json::Style &style,
+                 const colored_json::CompiledStyle &compiled) {
+  auto parser = colored_json::ParserPool::acquire();
+  try {
+    for (size_t i = 0; i < batch.docs.size(); i++) {
+      if (batch.first_doc + i > 0)
+        batch.output.push_back('\n');
+
+      std::string_view source = batch.docs[i];
+      simdjson::padded_string_view view(
+          source.data(), source.size(),
+          static_cast<size_t>(buffer_end - source.data()));
+      simdjson::ondemand::document doc = parser->iterate(view);
+      simdjson::ondemand::value val;
+      auto val_error = doc.get_value().get(val);
+      if (val_error) {
+        throw std::runtime_error("Kan root value niet ophalen");
+      }
+      renderValue(batch.output, style, compiled, val);
+    }
+  } catch (...) {
+    batch.error = std::current_exception();
+  }
+  batch.done.store(true, std::memory_order_release);
+}
+
+// --threads N: de hoofdthread zoekt met iterate_many de documentgrenzen en
+// verdeelt batches over de workers. Een begrensde reorder buffer schrijft de
+// batches in de volgorde van de input. Faalt een batch of de scan, dan gaat
+// printColored verder vanaf het eerste niet geschreven document, zodat output
+// en foutmelding gelijk zijn aan die van de seriële modus.
+void printColoredParallel(simdjson::padded_string &json,
+                          const colored_json::Style &style,
+                          const colored_json::CompiledStyle &compiled,
+                          colored_json::OutputBuffer &out, size_t threads) {
+  // Batches die gerenderd worden of op hun beurt wachten. Vóór de pool
+  // gedeclareerd: de pool rondt bij het opruimen eerst alle taken af.
+  std::deque<std::unique_ptr<RenderBatch>> pending;
+  colored_json::ThreadPool pool(threads - 1); // De hoofdthread helpt mee
+  const size_t max_pending = threads * 2;
+  const char *buffer_end = json.data() + json.size() + simdjson::SIMDJSON_PADDING;
+
+  // Aantal geschreven documenten; na een fout schrijven we niets meer parallel
+  size_t written_docs = 0;
+  bool failed = false;
+  auto writeFront = [&] {
+    RenderBatch &batch = *pending.front();
+    pool.helpUntil(
+        [&] { return batch.done.load(std::memory_order_acquire); });
+    if (batch.error) {
+      failed = true;
+      return;
+    }
+    out.append(batch.output.view());
+    written_docs += batch.docs.size();
+    pending.pop_front();
+  };
+
+  auto batch = std::make_unique<RenderBatch>();
+  size_t batch_bytes = 0;
+  size_t doc_count = 0;
+  auto submit = [&] {
+    RenderBatch *ready = batch.get();
+    pending.push_back(std::move(batch));
+    pool.submit([ready, buffer_end, &style, &compiled] {
+      renderBatch(*ready, buffer_end, style, compiled);
+    });
+    batch = std::make_unique<RenderBatch>();
+    batch->first_doc = doc_count;
+    batch_bytes = 0;
+    while (!failed && pending.size() > max_pending)
+      writeFront();
+  };
+
+  colored_json::JsonParser parser;
+  auto stream = parser.parseMany(json);
+  for (auto it = stream.begin(); !failed && it != stream.end(); ++it) {
+    if ((*it).error()) {
+      failed = true;
+      break;
+    }
+    // Bij een onvolledig document loopt source() door tot in de padding
+    std::string_view source = it.source();
+    size_t available = static_cast<size_t>(json.data() + json.size() - source.data());
+    if (source.size() > available)
+      source = source.substr(0, available);
+    batch->docs.push_back(source);
+    batch_bytes += source.size();
+    doc_count++;
+    if (batch_bytes >= BATCH_BYTES)
+      submit();
+  }
+  if (!failed && !batch->docs.empty())
+    submit();
+  while (!failed && !pending.empty())
+    writeFront();
+  if (failed)
+    printColored(json, style, compiled, out, written_docs);
+}
+
 int main(int argc, char *argv[]) {
   try {
     // Parse command line
@@ -189,67 +421,41 @@ int main(int argc, char *argv[]) {
     style.color_mode = parseColorMode(opts.color_mode_str);
     style.compact = opts.compact;
     style.indent_size = opts.indent_size;
+    style.verbatim_strings = opts.verbatim;
 
-    // Create printer
-    colored_json::Printer printer(style);
+    if (opts.filter != ".") {
+      std::cerr << "Niet-ondersteunde filter: " << opts.filter << "\n";
+      std::cerr << "Ondersteunde filters: .\n";
+      return 1;
+    }
+
+    // Kleuren en fragmenten eenmalig voor alle documenten
+    colored_json::CompiledStyle compiled =
+        colored_json::CompiledStyle::ansi(style);
 
     // Use padded_string to ensure lifetime
     simdjson::padded_string padded_json(json_str);
 
-    // Execute filter (nu ondersteunen we iterate_many voor JSONL)
-    colored_json::JsonParser parser;
-    auto stream = parser.parseMany(padded_json);
-
-    bool first_doc = true;
-    for (auto doc_res : stream) {
-      if (!first_doc)
-        std::cout << "\n";
-      first_doc = false;
-
-      auto doc = doc_res.value();
-
-      if (opts.filter == ".") {
-        simdjson::ondemand::value val;
-        auto val_error = doc.get_value().get(val);
-        if (val_error) {
-          throw std::runtime_error("Kan root value niet ophalen");
-        }
-
-        simdjson::ondemand::json_type type;
-        auto type_error = val.type().get(type);
-        if (type_error) {
-          throw std::runtime_error("Kan JSON type niet bepalen");
-        }
-
-        // Print based on type
-        if (type == simdjson::ondemand::json_type::object) {
-          simdjson::ondemand::object obj;
-          auto obj_error = val.get_object().get(obj);
-          if (obj_error) {
-            throw std::runtime_error("Kan object niet ophalen");
-          }
-          printer.printDictJson(obj, "");
-        } else if (type == simdjson::ondemand::json_type::array) {
-          simdjson::ondemand::array arr;
-          auto arr_error = val.get_array().get(arr);
-          if (arr_error) {
-            throw std::runtime_error("Kan array niet ophalen");
-          }
-          printer.printListJson(arr, "");
-        } else {
-          printer.printValueJson(val, "");
-        }
-
-        std::cout << printer.str();
-        printer.clear();
+    // Output in blokken naar stdout; bij een fout eerst de al geschreven
+    // documenten wegschrijven
+    colored_json::FileSink sink(stdout);
+    colored_json::OutputBuffer out;
+    out.setSink(&sink);
+    try {
+      size_t threads = colored_json::resolveThreadCount(opts.threads);
+      if (!compiled.hasColor()) {
+        printPlain(padded_json, style, compiled, out);
+      } else if (threads > 1) {
+        printColoredParallel(padded_json, style, compiled, out, threads);
       } else {
-        std::cerr << "Niet-ondersteunde filter: " << opts.filter << "\n";
-        std::cerr << "Ondersteunde filters: .\n";
-        return 1;
+        printColored(padded_json, style, compiled, out);
       }
+      out.push_back('\n');
+    } catch (...) {
+      out.flush();
+      throw;
     }
-
-    std::cout << "\n";
+    out.flush();
     return 0;
 
   } catch (const std::exception &e) {
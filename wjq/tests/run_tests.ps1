@@ -42,6 +42,33 @@ Run-Test "Theme: Neon" "-t neon $testData\simple.json"
 # Compact test
 Run-Test "Compact output" "-c $testData\simple.json"
 
+# Plain output (geen kleur)
+Run-Test "Color mode disabled" "-m disabled $testData\mixed.jsonl"
+Run-Test "Color mode disabled compact" "-m disabled -c $testData\simple.json"
+Run-Test "Color mode disabled big integers" "-m disabled $testData\bigint.jsonl"
+Run-Test "Color mode disabled big integers compact" "-m disabled -c $testData\bigint.jsonl"
+
+# Verbatim strings test
+Run-Test "Verbatim strings" "--verbatim $testData\simple.json"
+
+# Parallel JSONL
+Run-Test "Threads JSONL" "--threads 4 $testData\mixed.jsonl"
+Run-Test "Threads invalid" "--threads -1 $testData\mixed.jsonl" $false
+
+# Ongeldige JSONL: --threads geeft dezelfde output en foutmelding als serieel
+Write-Host "Running Test: Threads malformed" -ForegroundColor Cyan
+$serial = (& $wjq -m 16 "$testData\malformed.jsonl" 2>&1 | Out-String)
+$serialExit = $LASTEXITCODE
+$parallel = (& $wjq -m 16 --threads 4 "$testData\malformed.jsonl" 2>&1 | Out-String)
+$parallelExit = $LASTEXITCODE
+if ($serial -eq $parallel -and $serialExit -ne 0 -and $serialExit -eq $parallelExit) {
+    Write-Host "PASS: Threads malformed" -ForegroundColor Green
+}
+else {
+    Write-Host "FAIL: Threads malformed (output differs from serial mode)" -ForegroundColor Red
+}
+Write-Host "-----------------------------------"
+
 # Stdin test
 Write-Host "Running Test: Stdin" -ForegroundColor Cyan
 "{`"stdin`": true}" | & $wjq